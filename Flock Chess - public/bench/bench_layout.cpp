@@ -0,0 +1,103 @@
+// bench_layout.cpp
+// Fancy magic layout vs the old per-square vectors.
+//
+// The "legacy" side rebuilds the previous RookMagic/BishopMagic layout (one
+// std::vector<Bitboard> per square) from the generated tables, then both
+// layouts answer the same stream of random (piece, square, occupancy)
+// queries.
+//
+// Usage: bench_layout [lookups]
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "attacks.h"
+#include "bench_util.h"
+
+struct LegacyMagic {
+    Bitboard mask;
+    Bitboard magic;
+    int shift;
+    std::vector<Bitboard> attacks;
+};
+
+static const int NUM_SLIDERS = 2;
+static LegacyMagic legacy[NUM_SLIDERS][64];
+static const SliderMagic* fancy[NUM_SLIDERS] = { rookMagics, bishopMagics };
+
+struct Query {
+    uint8_t piece;
+    uint8_t sq;
+    Bitboard occ;
+};
+
+static size_t build_legacy() {
+    size_t bytes = 0;
+    for (int p = 0; p < NUM_SLIDERS; p++) {
+        for (int sq = 0; sq < 64; sq++) {
+            const SliderMagic& M = fancy[p][sq];
+            LegacyMagic& L = legacy[p][sq];
+            size_t size = size_t(1) << (64 - M.shift);
+            L.mask = M.mask;
+            L.magic = M.magic;
+            L.shift = (int)M.shift;
+            L.attacks.assign(sliderAttacks + M.offset, sliderAttacks + M.offset + size);
+            bytes += sizeof(LegacyMagic) + size * sizeof(Bitboard);
+        }
+    }
+    return bytes;
+}
+
+static inline Bitboard legacy_lookup(const Query& q) {
+    const LegacyMagic& L = legacy[q.piece][q.sq];
+    return L.attacks[((q.occ & L.mask) * L.magic) >> L.shift];
+}
+
+static inline Bitboard fancy_lookup(const Query& q) {
+    return slider_attacks(fancy[q.piece][q.sq], q.occ);
+}
+
+template <typename F>
+static void run(const char* name, F lookup, const std::vector<Query>& queries, long lookups) {
+    CacheCounters counters;
+    Bitboard sink = 0;
+    size_t n = queries.size();
+
+    counters.start();
+    auto t0 = Clock::now();
+    for (long i = 0; i < lookups; ++i)
+        sink ^= lookup(queries[i % n]);
+    double secs = seconds_since(t0);
+    counters.stop();
+
+    std::printf("%-8s %12ld lookups  %8.3f s  %14.0f lookups/s  (sink %016llx)\n",
+                name, lookups, secs, lookups / secs, (unsigned long long)sink);
+    counters.print(name);
+}
+
+int main(int argc, char* argv[]) {
+    long lookups = argc > 1 ? std::atol(argv[1]) : 50000000L;
+
+    size_t legacyBytes = build_legacy();
+    size_t magicBytes = NUM_SLIDERS * 64 * sizeof(SliderMagic);
+    size_t fancyBytes = sliderAttacksSize * sizeof(Bitboard) + magicBytes;
+    std::printf("footprint: fancy %zu bytes (%u attack slots + %zu bytes of magics)\n",
+                fancyBytes, sliderAttacksSize, magicBytes);
+    std::printf("footprint: legacy %zu bytes in %d heap blocks (+ allocator headers)\n",
+                legacyBytes, NUM_SLIDERS * 64);
+
+    // Random piece and square per query, so consecutive lookups land in
+    // different tables the way movegen's do.
+    std::mt19937_64 rng(0x5EEDULL);
+    std::vector<Query> queries(1 << 16);
+    for (auto& q : queries) {
+        q.piece = (uint8_t)(rng() % NUM_SLIDERS);
+        q.sq = (uint8_t)(rng() & 63);
+        q.occ = rng() & rng();
+    }
+
+    run("legacy", legacy_lookup, queries, lookups);
+    run("fancy", fancy_lookup, queries, lookups);
+    return 0;
+}
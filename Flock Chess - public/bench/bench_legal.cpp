@@ -0,0 +1,72 @@
+// bench_legal.cpp
+// Legal move generation: pin/check masks vs make-and-test.
+//
+// Both sides produce the legal moves of the same set of standard-rules
+// positions. The baseline generates pseudo-legal moves and keeps those
+// after which make_move leaves the mover's king unattacked.
+//
+// Usage: bench_legal [rounds]
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "legal.h"
+#include "bench_util.h"
+
+static const std::vector<char> PIECES = { 'K', 'Q', 'R', 'B', 'N', 'P', 'k', 'q', 'r', 'b', 'n', 'p' };
+
+static const char* FENS[] = {
+    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+    "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+    "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+    "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+};
+
+int main(int argc, char* argv[]) {
+    long rounds = argc > 1 ? std::atol(argv[1]) : 500000L;
+
+    Zobrist z;
+    init_zobrist(z, PIECES, 0);
+    std::vector<Bitboards> boards;
+    for (const char* fen : FENS) {
+        Bitboards bb = parse_fen_bitboards(fen, PIECES);
+        bb.zobrist_hash = compute_zobrist(bb, z);
+        boards.push_back(bb);
+    }
+    size_t n = boards.size();
+    MoveList list;
+
+    uint64_t legalMoves = 0;
+    auto t0 = Clock::now();
+    for (long i = 0; i < rounds; ++i) {
+        generate_legal(boards[i % n], list);
+        legalMoves += list.size;
+    }
+    double legalSecs = seconds_since(t0);
+
+    uint64_t testedMoves = 0;
+    UndoInfo undo;
+    t0 = Clock::now();
+    for (long i = 0; i < rounds; ++i) {
+        Bitboards& bb = boards[i % n];
+        bool white = bb.w_to_move;
+        generate_pseudo_legal(bb, list);
+        for (Move m : list) {
+            make_move(bb, m, undo, z);
+            testedMoves += !king_in_check(bb, white);
+            unmake_move(bb, m, undo);
+        }
+    }
+    double testSecs = seconds_since(t0);
+
+    std::printf("%-14s %10ld positions  %8.3f s  %8.1f ns/position  (%llu moves)\n",
+                "legal", rounds, legalSecs, legalSecs * 1e9 / rounds, (unsigned long long)legalMoves);
+    std::printf("%-14s %10ld positions  %8.3f s  %8.1f ns/position  (%llu moves)\n",
+                "make-and-test", rounds, testSecs, testSecs * 1e9 / rounds, (unsigned long long)testedMoves);
+    if (legalMoves != testedMoves) {
+        std::fprintf(stderr, "bench_legal: move counts differ\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,65 @@
+// bench_makemove.cpp
+// make_move/unmake_move throughput on the Flock-Chess start position.
+//
+// The move list is every pseudo-move of White's pieces from movegen(), each
+// also relocating the first duck to an empty square, so a pair exercises
+// the piece, duck, castling-mask and hash updates together.
+//
+// Usage: bench_makemove [pairs] [variants.ini]
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "makemove.h"
+#include "parser.h"
+#include "bench_util.h"
+
+int main(int argc, char* argv[]) {
+    long pairs = argc > 1 ? std::atol(argv[1]) : 20000000L;
+    std::string ini = argc > 2 ? argv[2] : FLOCK_VARIANTS_INI;
+
+    auto variants = parse(ini);
+    auto it = variants.find("Flock-Chess");
+    if (it == variants.end()) {
+        std::fprintf(stderr, "bench_makemove: no Flock-Chess variant in %s\n", ini.c_str());
+        return 1;
+    }
+    const Variant& v = it->second;
+
+    init_attack_tables();
+    Zobrist z;
+    init_zobrist(z, v.pieces, 0);
+    Bitboards bb = parse_fen_bitboards(v.stdPos, v.pieces, v.neutralPieces);
+    bb.zobrist_hash = compute_zobrist(bb, z);
+
+    MoveTargets targets;
+    movegen(bb, v.programs, targets);
+
+    int duck = indexLSB(bb.n_occupancy);
+    std::vector<Move> moves;
+    for (Bitboard from = bb.w_occupancy; from; from &= from - 1) {
+        int sq = indexLSB(from);
+        for (Bitboard to = targets.quiet[sq] | targets.captures[sq]; to; to &= to - 1) {
+            int target = indexLSB(to);
+            Bitboard free = ~bb.occupancy & ~(1ULL << target);
+            Move m = make_move_code(sq, target, NORMAL, (targets.captures[sq] >> target) & 1);
+            moves.push_back(with_duck(m, duck, indexLSB(free)));
+        }
+    }
+    std::printf("%zu moves in the list\n", moves.size());
+
+    uint64_t sink = 0;
+    UndoInfo undo;
+    auto t0 = Clock::now();
+    for (long i = 0; i < pairs; ++i) {
+        Move m = moves[i % moves.size()];
+        make_move(bb, m, undo, z);
+        sink += bb.zobrist_hash;
+        unmake_move(bb, m, undo);
+    }
+    double secs = seconds_since(t0);
+
+    std::printf("make/unmake %10ld pairs  %8.3f s  %12.0f pairs/s  %6.1f ns/pair  (sink %016llx)\n",
+                pairs, secs, pairs / secs, secs * 1e9 / pairs, (unsigned long long)sink);
+    return bb.zobrist_hash == compute_zobrist(bb, z) ? 0 : 1;
+}
@@ -0,0 +1,134 @@
+// bench_movegen.cpp
+// Whole-board movegen on the Flock-Chess start position: the old path that
+// parses each piece's Moveset string per square and finds the piece by
+// scanning a letter-keyed map, against movegen() with compiled attack
+// programs (see AttackProgram in attacks.h) and the square mailbox: merged
+// boards by value, quiet/capture split into a caller buffer, and the
+// capture-only mode.
+//
+// The "legacy" side is a copy of the previous evaluate_expr/run_attack
+// pair (stringstream + stoi + unordered_map per occupied square) and piece
+// search over the old unordered_map<char, Bitboard>, driving the same three
+// piece passes as movegen().
+//
+// Usage: bench_movegen [iterations] [variants.ini]
+
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <unordered_map>
+#include "movegen.h"
+#include "parser.h"
+#include "bench_util.h"
+
+static std::unordered_map<int, AttackFunc> legacyMap;
+
+static Bitboard run_attack(int code, int sq, Bitboard occ) {
+    auto it = legacyMap.find(code);
+    if (it == legacyMap.end())
+        throw std::runtime_error("Unknown attack code: " + std::to_string(code));
+    return it->second(sq, occ);
+}
+
+static Bitboard evaluate_expr(const std::string& s, int sq, Bitboard occ) {
+    if (s.find('+') == std::string::npos)
+        return run_attack(std::stoi(s), sq, occ);
+
+    std::stringstream ss(s);
+    std::string token;
+    Bitboard result = 0;
+    while (std::getline(ss, token, '+'))
+        result ^= run_attack(std::stoi(token), sq, occ);
+    return result;
+}
+
+using PieceMap = std::unordered_map<char, Bitboard>;
+
+static std::array<Bitboard, 64> legacy_pass(const PieceMap& boards,
+                                            const std::unordered_map<char, std::string>& exprs,
+                                            Bitboard from, Bitboard occ) {
+    std::array<Bitboard, 64> moves{};
+    Bitboard remaining = from;
+    while (remaining) {
+        int sq = indexLSB(remaining);
+        remaining &= remaining - 1;
+
+        char found = 0;
+        for (auto& [piece, board] : boards) {
+            if (board & (1ULL << sq)) {
+                found = piece;
+                break;
+            }
+        }
+        auto it = exprs.find(found);
+        if (!found || it == exprs.end())
+            continue;
+        moves[sq] = evaluate_expr(it->second, sq, occ) & ~occ;
+    }
+    return moves;
+}
+
+static std::array<Bitboard, 64> legacy_movegen(const Bitboards& bb, const PieceMap& boards,
+                                               const std::unordered_map<char, std::string>& exprs) {
+    auto moves = legacy_pass(boards, exprs, bb.w_occupancy, bb.w_occupancy);
+    auto black = legacy_pass(boards, exprs, bb.b_occupancy, bb.b_occupancy);
+    auto neutral = legacy_pass(boards, exprs, bb.occupancy & ~(bb.w_occupancy | bb.b_occupancy), bb.occupancy);
+    for (int sq = 0; sq < 64; sq++)
+        moves[sq] |= black[sq] | neutral[sq];
+    return moves;
+}
+
+template <typename F>
+static double run(const char* name, F gen, long iterations) {
+    Bitboard sink = 0;
+    auto t0 = Clock::now();
+    for (long i = 0; i < iterations; ++i) {
+        auto moves = gen();
+        sink ^= moves[i & 63];
+    }
+    double secs = seconds_since(t0);
+    std::printf("%-8s %10ld movegens  %8.3f s  %10.0f ns/movegen  (sink %016llx)\n",
+                name, iterations, secs, secs * 1e9 / iterations, (unsigned long long)sink);
+    return secs;
+}
+
+int main(int argc, char* argv[]) {
+    long iterations = argc > 1 ? std::atol(argv[1]) : 200000L;
+    std::string ini = argc > 2 ? argv[2] : FLOCK_VARIANTS_INI;
+
+    auto variants = parse(ini);
+    auto it = variants.find("Flock-Chess");
+    if (it == variants.end()) {
+        std::fprintf(stderr, "bench_movegen: no Flock-Chess variant in %s\n", ini.c_str());
+        return 1;
+    }
+    const Variant& v = it->second;
+
+    init_attack_tables();
+    for (int code = 0; code < NUM_MOVESET_CODES; code++)
+        if (AttackFunc f = attack_function(code))
+            legacyMap[code] = f;
+
+    Bitboards bb = parse_fen_bitboards(v.stdPos, v.pieces, v.neutralPieces);
+    PieceMap boards = bb.pieceBoards();
+
+    // The legacy passes ran on the old occupancy convention, where both
+    // side boards held every non-neutral piece.
+    Bitboards old = bb;
+    old.w_occupancy = old.b_occupancy = bb.w_occupancy | bb.b_occupancy;
+
+    double legacy = run("legacy", [&] { return legacy_movegen(old, boards, v.movesets); }, iterations);
+    double compiled = run("compiled", [&] { return movegen(bb, v.programs); }, iterations);
+    MoveTargets targets;
+    double split = run("split", [&]() -> const MoveBoards& {
+        movegen(bb, v.programs, targets);
+        return targets.quiet;
+    }, iterations);
+    double captures = run("captures", [&]() -> const MoveBoards& {
+        movegen(bb, v.programs, targets, CAPTURES);
+        return targets.captures;
+    }, iterations);
+    std::printf("speedup  %.2fx (compiled)  %.2fx (split)  %.2fx (captures)\n",
+                legacy / compiled, legacy / split, legacy / captures);
+    return 0;
+}
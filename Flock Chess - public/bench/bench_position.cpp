@@ -0,0 +1,76 @@
+// bench_position.cpp
+// Copy and hash-update cost: Bitboards (with a heap-backed vector) vs
+// the fixed-size Position (position.h) on the Flock-Chess start position.
+//
+// "copy" clones the whole position; "hash" moves a knight out and back and
+// brings the Zobrist key up to date, by a full compute_zobrist() on
+// Bitboards and by XORing the two square keys on Position.
+//
+// Usage: bench_position [iterations]
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "position.h"
+#include "bench_util.h"
+
+static const char* FLOCK_START = "rnbqkbnr/pppppppp/8/1D1D1D/2D1D1/8/PPPPPPPP/RNBQKBNR w KQkq - 0-1";
+
+template <typename F>
+static void run(const char* name, F body, long iterations) {
+    uint64_t sink = 0;
+    auto t0 = Clock::now();
+    for (long i = 0; i < iterations; ++i)
+        sink ^= body(i);
+    double secs = seconds_since(t0);
+    std::printf("%-16s %10ld iters  %8.3f s  %8.1f ns/iter  (sink %016llx)\n",
+                name, iterations, secs, secs * 1e9 / iterations, (unsigned long long)sink);
+}
+
+int main(int argc, char* argv[]) {
+    long iterations = argc > 1 ? std::atol(argv[1]) : 2000000L;
+
+    std::vector<char> pieces = { 'K', 'Q', 'R', 'B', 'N', 'P', 'k', 'q', 'r', 'b', 'n', 'p', 'D' };
+    Zobrist z;
+    init_zobrist(z, pieces, 0);
+
+    Bitboards bb = parse_fen_bitboards(FLOCK_START, pieces);
+    bb.zobrist_hash = compute_zobrist(bb, z);
+    Position pos = to_position(bb);
+    std::printf("sizeof(Position) = %zu bytes\n", sizeof(Position));
+
+    // g1 <-> f3 for the white knight
+    const int from = 6, to = 21;
+    const int knight = z.piece_idx.at('N');
+
+    // Copies go into a ring of live slots so the compiler cannot drop them
+    std::vector<Bitboards> bbSlots(16, bb);
+    std::vector<Position> posSlots(16, pos);
+    run("copy Bitboards", [&](long i) {
+        Bitboards& dst = bbSlots[i & 15];
+        dst = bbSlots[(i + 7) & 15];
+        dst.zobrist_hash += (uint64_t)i;
+        return dst.zobrist_hash;
+    }, iterations);
+    run("copy Position", [&](long i) {
+        Position& dst = posSlots[i & 15];
+        dst = posSlots[(i + 7) & 15];
+        dst.hash += (uint64_t)i;
+        return dst.hash;
+    }, iterations);
+
+    run("hash Bitboards", [&](long i) {
+        Bitboard fromTo = (1ULL << from) | (1ULL << to);
+        bb.pieceBB[bb.piece_id('N')] ^= fromTo;
+        bb.occupancy ^= fromTo;
+        bb.zobrist_hash = compute_zobrist(bb, z);
+        return bb.zobrist_hash ^ (uint64_t)i;
+    }, iterations);
+    run("hash Position", [&](long i) {
+        int a = (i & 1) ? to : from, b = (i & 1) ? from : to;
+        pos.move_piece(a, b);
+        pos.hash ^= z.piece_square[knight][a] ^ z.piece_square[knight][b];
+        return pos.hash ^ (uint64_t)i;
+    }, iterations);
+    return 0;
+}
@@ -0,0 +1,99 @@
+// bench_search.cpp
+// Search throughput and time-to-depth on a fixed position set.
+//
+// Each position is searched from an empty table to the given depth; the
+// report is the time the last iteration finished, the nodes and the nps,
+// then the totals over the set. With a list of thread counts the set is
+// run once per count (Lazy SMP) and a scaling table closes the report:
+// time-to-depth speedup and nps relative to the first count.
+//
+// Usage: bench_search [depth] [hash MB] [threads, e.g. 1,2,4,8,16]
+
+#include <cstdio>
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+#include "search.h"
+#include "bench_util.h"
+
+struct BenchPosition {
+    const char* variant;
+    const char* fen;        // nullptr: the variant's start position
+};
+
+static const BenchPosition POSITIONS[] = {
+    { "QE chess", nullptr },
+    { "QE chess", "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1" },
+    { "QE chess", "r1bq1rk1/pp2bppp/2n1pn2/3p4/2PP4/2N2N2/PP2BPPP/R2QKB1R w KQ - 0 8" },
+    { "QE chess", "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1" },
+    { "Marseillais Chess", nullptr },
+    { "Marseillais Chess", "r1bqkb1r/pppp1ppp/2n2n2/4p3/2B1P3/5N2/PPPP1PPP/RNBQK2R w KQkq - 0 4" },
+    { "Flock-Chess", nullptr },
+    { "Flock-Chess", "r1bqkb1r/pppp1ppp/2n2n2/4p3/2B1P3/3D1N2/PPPP1PPP/RNBQK2R w KQkq - 0 4" },
+};
+
+struct Totals {
+    int threads;
+    uint64_t nodes = 0;
+    double seconds = 0.0;
+};
+
+static Totals run_set(const std::unordered_map<std::string, Variant>& variants, TranspositionTable& tt,
+                      int threads, int depth) {
+    Totals totals{ threads };
+    std::printf("threads %d\n", threads);
+    for (const BenchPosition& p : POSITIONS) {
+        const Variant& v = variants.at(p.variant);
+        GameRules rules = rules_for(v);
+        Zobrist z;
+        init_zobrist(z, v.pieces, 0);
+        Bitboards bb = setup_board(v, rules, p.fen ? p.fen : v.stdPos);
+        bb.zobrist_hash = compute_zobrist(bb, z);
+
+        tt.clear();
+        SearchPool pool(rules, z, tt, threads);
+        SearchLimits limits;
+        limits.depth = depth;
+        auto t0 = Clock::now();
+        SearchResult r = pool.search(bb, History(), limits);
+        double secs = seconds_since(t0);
+        uint64_t nodes = pool.node_count();
+
+        std::printf("  %-18s depth %2d  %8.3f s  %12llu nodes  %10.0f nps  %-8s %s\n",
+                    p.variant, r.info.depth, secs, (unsigned long long)nodes, nodes / secs,
+                    move_to_string(bb, r.best).c_str(), score_to_string(r.info.score).c_str());
+        totals.nodes += nodes;
+        totals.seconds += secs;
+    }
+    std::printf("  total: %.3f s  %llu nodes  %.0f nps\n\n",
+                totals.seconds, (unsigned long long)totals.nodes, totals.nodes / totals.seconds);
+    return totals;
+}
+
+int main(int argc, char* argv[]) {
+    int depth = argc > 1 ? std::atoi(argv[1]) : 6;
+    size_t hashMb = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 64;
+    std::vector<int> threadCounts;
+    for (const char* t = argc > 3 ? argv[3] : "1"; *t; ) {
+        char* end;
+        threadCounts.push_back(std::max(1, static_cast<int>(std::strtol(t, &end, 10))));
+        t = *end ? end + 1 : end;
+    }
+
+    init_attack_tables();
+    auto variants = parse(FLOCK_VARIANTS_INI);
+    TranspositionTable tt(hashMb);
+
+    std::vector<Totals> runs;
+    for (int threads : threadCounts)
+        runs.push_back(run_set(variants, tt, threads, depth));
+
+    if (runs.size() > 1) {
+        std::printf("threads  time-to-depth  speedup        nps  nps ratio\n");
+        for (const Totals& t : runs)
+            std::printf("%7d  %11.3f s  %6.2fx  %9.0f  %8.2fx\n", t.threads, t.seconds,
+                        runs[0].seconds / t.seconds, t.nodes / t.seconds,
+                        (t.nodes / t.seconds) / (runs[0].nodes / runs[0].seconds));
+    }
+    return 0;
+}
@@ -0,0 +1,92 @@
+// bench_tt.cpp
+// Transposition table probe latency and hit rate.
+//
+// "random" fills the table, then probes random keys, half of them stored:
+// one dependent cache miss per probe, the case huge pages help. "tree"
+// walks the legal move tree of the standard start position, probing each
+// node before storing it, and reports how many nodes were transpositions.
+//
+// Usage: bench_tt [table MB] [tree depth]
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "legal.h"
+#include "tt.h"
+#include "bench_util.h"
+
+static const std::vector<char> PIECES = { 'K', 'Q', 'R', 'B', 'N', 'P', 'k', 'q', 'r', 'b', 'n', 'p' };
+
+struct TreeStats {
+    uint64_t nodes = 0;
+    uint64_t hits = 0;
+};
+
+static void walk(Bitboards& bb, const Zobrist& z, TranspositionTable& tt, int depth, TreeStats& stats) {
+    stats.nodes++;
+    TTData d;
+    if (tt.probe(bb.zobrist_hash, d) && d.depth >= depth) {
+        stats.hits++;
+        return;
+    }
+    if (depth > 0) {
+        MoveList list;
+        generate_legal(bb, list);
+        for (Move m : list) {
+            UndoInfo undo;
+            make_move(bb, m, undo, z);
+            walk(bb, z, tt, depth - 1, stats);
+            unmake_move(bb, m, undo);
+        }
+    }
+    tt.store(bb.zobrist_hash, NO_MOVE, 0, depth, BOUND_EXACT);
+}
+
+int main(int argc, char* argv[]) {
+    size_t megabytes = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 256;
+    int depth = argc > 2 ? std::atoi(argv[2]) : 5;
+
+    TranspositionTable tt(megabytes);
+    std::printf("table: %zu MB, %zu clusters\n", megabytes, tt.cluster_count());
+
+    // Random probes
+    const long stored = static_cast<long>(tt.cluster_count()) * 2;
+    const long probes = 20000000L;
+    std::mt19937_64 rng(0x77ULL);
+    std::vector<uint64_t> keys(1 << 20);
+    for (auto& k : keys) k = rng();
+    for (long i = 0; i < stored; i++)
+        tt.store(keys[i & (keys.size() - 1)] ^ (uint64_t)(i >> 20) * 0x9E3779B97F4A7C15ULL,
+                 NO_MOVE, 0, 1, BOUND_EXACT);
+
+    uint64_t hits = 0;
+    TTData d;
+    auto t0 = Clock::now();
+    for (long i = 0; i < probes; i++) {
+        // Odd i: a stored key; even i: a fresh one
+        long j = (i * 7919) % stored;
+        uint64_t key = (i & 1) ? keys[j & (keys.size() - 1)] ^ (uint64_t)(j >> 20) * 0x9E3779B97F4A7C15ULL
+                               : rng();
+        hits += tt.probe(key, d);
+    }
+    double secs = seconds_since(t0);
+    std::printf("%-8s %10ld probes  %8.3f s  %6.1f ns/probe  hit rate %5.1f%%  hashfull %d\n",
+                "random", probes, secs, secs * 1e9 / probes, 100.0 * hits / probes, tt.hashfull());
+
+    // Tree walk
+    tt.clear();
+    Zobrist z;
+    init_zobrist(z, PIECES, 0);
+    Bitboards bb = parse_fen_bitboards("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", PIECES);
+    bb.zobrist_hash = compute_zobrist(bb, z);
+
+    TreeStats stats;
+    t0 = Clock::now();
+    walk(bb, z, tt, depth, stats);
+    secs = seconds_since(t0);
+    std::printf("%-8s %10llu nodes   %8.3f s  %6.1f ns/node   hit rate %5.1f%%  hashfull %d\n",
+                "tree", (unsigned long long)stats.nodes, secs, secs * 1e9 / stats.nodes,
+                100.0 * stats.hits / stats.nodes, tt.hashfull());
+    return 0;
+}
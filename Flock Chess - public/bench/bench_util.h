@@ -0,0 +1,91 @@
+// bench_util.h
+// Timing and best-effort hardware cache counters shared by the benchmarks.
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+#ifdef __linux__
+    #include <linux/perf_event.h>
+    #include <sys/ioctl.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+    #include <cstring>
+#endif
+
+using Clock = std::chrono::steady_clock;
+
+inline double seconds_since(Clock::time_point t0) {
+    return std::chrono::duration<double>(Clock::now() - t0).count();
+}
+
+// L1D and last-level cache read misses of the calling thread, via
+// perf_event_open. Containers and VMs without a PMU simply report n/a.
+class CacheCounters {
+public:
+    CacheCounters() {
+#ifdef __linux__
+        fds[0] = open_counter(PERF_COUNT_HW_CACHE_L1D);
+        fds[1] = open_counter(PERF_COUNT_HW_CACHE_LL);
+#endif
+    }
+    ~CacheCounters() {
+#ifdef __linux__
+        for (int fd : fds)
+            if (fd >= 0) close(fd);
+#endif
+    }
+
+    bool available() const { return fds[0] >= 0 && fds[1] >= 0; }
+
+    void start() {
+#ifdef __linux__
+        for (int fd : fds) {
+            if (fd < 0) continue;
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    void stop() {
+#ifdef __linux__
+        for (int i = 0; i < 2; i++) {
+            counts[i] = 0;
+            if (fds[i] < 0) continue;
+            ioctl(fds[i], PERF_EVENT_IOC_DISABLE, 0);
+            if (read(fds[i], &counts[i], sizeof(counts[i])) != sizeof(counts[i]))
+                counts[i] = 0;
+        }
+#endif
+    }
+
+    void print(const char* label) const {
+        if (!available()) {
+            std::printf("%-8s L1D misses: n/a  LLC misses: n/a\n", label);
+            return;
+        }
+        std::printf("%-8s L1D misses: %llu  LLC misses: %llu\n", label,
+                    (unsigned long long)counts[0], (unsigned long long)counts[1]);
+    }
+
+private:
+    int fds[2] = { -1, -1 };
+    uint64_t counts[2] = { 0, 0 };
+
+#ifdef __linux__
+    static int open_counter(uint64_t cache) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.size = sizeof(attr);
+        attr.config = cache
+                    | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                    | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    }
+#endif
+};
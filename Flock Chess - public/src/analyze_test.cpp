@@ -54,9 +54,11 @@ int main(int argc, char* argv[]) {
         return 1;
     }
 
-    Bitboards out = parse_fen_bitboards(fen);
+    init_attack_tables();
+
+    Bitboards out = parse_fen_bitboards(fen, v.pieces, v.neutralPieces);
     // print_Bitboards(out);
-    std::array<uint64_t, 64> moves = movegen(out, v.movesets);
+    std::array<uint64_t, 64> moves = movegen(out, v.programs);
 
     print_moves_json(moves);
     return 0;
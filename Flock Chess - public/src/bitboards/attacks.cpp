@@ -0,0 +1,98 @@
+#include "attacks.h"
+#include <mutex>
+#include <stdexcept>
+
+void init_attack_tables() {
+    static std::once_flag once;
+    std::call_once(once, init_fairy_tables);
+}
+
+// Indexed by moveset code (see var_moveset.txt)
+static const AttackFunc attackFunctions[NUM_MOVESET_CODES] = {
+    nullptr,
+    rook_attacks,               // 1
+    bishop_attacks,             // 2
+    knight_attacks,             // 3
+    fairy_attacks<4>,
+    fairy_attacks<5>,
+    fairy_attacks<6>,
+    fairy_attacks<7>,
+    fairy_attacks<8>,
+    fairy_attacks<9>,
+    fairy_attacks<10>,
+    fairy_attacks<11>,
+    fairy_attacks<12>,
+    fairy_attacks<13>,
+    fairy_attacks<14>,
+    nullptr,                    // 15 parametric
+    king_attacks,               // 16
+    white_pawn_attacks,         // 17
+    fairy_attacks<18>,
+    duck_attacks,               // 19
+    black_pawn_attacks,         // 20
+    fairy_attacks<21>,
+    fairy_attacks<22>,
+};
+
+AttackFunc attack_function(int code) {
+    if (code < 0 || code >= NUM_MOVESET_CODES)
+        return nullptr;
+    return attackFunctions[code];
+}
+
+// Code whose attacks from sq are the squares the given code attacks sq
+// from, or -1 when there is none (hoppers, the duck: both read the
+// board beyond their target)
+static int mirror_code(int code) {
+    switch (code) {
+    case 1: case 2: case 3: case 16: case 21: case 22:
+        return code;
+    case 4:  return 5;
+    case 5:  return 4;
+    case 6:  return 7;
+    case 7:  return 6;
+    case 8:  return 10;
+    case 10: return 8;
+    case 9:  return 11;
+    case 11: return 9;
+    case 17: return 20;
+    case 20: return 17;
+    default: return -1;
+    }
+}
+
+AttackProgram compile_moveset(const std::string& expr) {
+    AttackProgram program;
+    program.reversible = true;
+    size_t pos = 0;
+    do {
+        size_t plus = expr.find('+', pos);
+        std::string token = expr.substr(pos, plus == std::string::npos ? std::string::npos : plus - pos);
+        pos = plus == std::string::npos ? expr.size() : plus + 1;
+
+        size_t used = 0;
+        int code = -1;
+        try {
+            code = std::stoi(token, &used);
+        } catch (const std::exception&) {
+            throw std::runtime_error("Bad moveset term '" + token + "' in \"" + expr + "\"");
+        }
+        if (token.find_first_not_of(" \t", used) != std::string::npos)
+            throw std::runtime_error("Bad moveset term '" + token + "' in \"" + expr + "\"");
+
+        AttackFunc f = attack_function(code);
+        if (!f)
+            throw std::runtime_error("Unknown attack code: " + std::to_string(code));
+        if (program.count == AttackProgram::MAX_TERMS)
+            throw std::runtime_error("Too many terms in moveset \"" + expr + "\"");
+        int mirror = mirror_code(code);
+        program.reversible &= mirror >= 0;
+        program.reverseTerms[program.count] = mirror >= 0 ? attack_function(mirror) : nullptr;
+        program.terms[program.count++] = f;
+        if (code == 17 || code == 20)
+            program.pawn = code == 17 ? PAWN_WHITE : PAWN_BLACK;
+    } while (pos < expr.size());
+    if (program.count > 1)
+        program.pawn = 0;
+    return program;
+}
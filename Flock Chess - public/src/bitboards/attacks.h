@@ -0,0 +1,70 @@
+// attacks.h
+#pragma once
+#include <array>
+#include <string>
+#include "rook.h"
+#include "bishops.h"
+#include "duck.h"
+#include "knight.h"
+#include "king.h"
+#include "pawn.h"
+#include "fairy.h"
+
+// =====================================================
+// Process-wide attack tables
+// =====================================================
+// Slider magics are generated at build time and the duck and leaper tables
+// are constexpr, so every built-in table is ready before main(). The fairy
+// moveset codes (fairy.h) are compiled here, and their queries never check
+// for initialization: call this once before the first movegen. It is safe
+// to call from several threads and more than once.
+void init_attack_tables();
+
+// =====================================================
+// Moveset programs
+// =====================================================
+// A variant's Moveset entry ("1+2+3") names attack generators by their
+// var_moveset.txt code; the terms are XORed together. compile_moveset()
+// resolves the codes once, when the variant is loaded, so movegen only
+// walks a short array of function pointers.
+using AttackFunc = Bitboard(*)(int sq, Bitboard occ);
+
+// Generator for a moveset code, or nullptr if the code has none
+AttackFunc attack_function(int code);
+
+struct AttackProgram {
+    static constexpr int MAX_TERMS = 8;
+
+    uint8_t count = 0;
+    AttackFunc terms[MAX_TERMS] = {};
+    // PAWN_WHITE / PAWN_BLACK when the whole program is code 17 / 20: its
+    // terms give the captures and movegen adds the pushes set-wise
+    int8_t pawn = 0;
+    // Each term's mirror (left for right, black pawn for white pawn, a
+    // symmetric piece for itself): reverse(sq) holds the squares from which
+    // this piece would attack sq. Hoppers and the duck have no mirror.
+    bool reversible = false;
+    AttackFunc reverseTerms[MAX_TERMS] = {};
+
+    Bitboard operator()(int sq, Bitboard occ) const {
+        Bitboard result = 0ULL;
+        for (int i = 0; i < count; i++)
+            result ^= terms[i](sq, occ);
+        return result;
+    }
+
+    Bitboard reverse(int sq, Bitboard occ) const {
+        Bitboard result = 0ULL;
+        for (int i = 0; i < count; i++)
+            result ^= reverseTerms[i](sq, occ);
+        return result;
+    }
+};
+
+enum PawnProgram : int8_t { PAWN_WHITE = 1, PAWN_BLACK = -1 };
+
+// One program per piece letter; letters without a moveset stay empty
+using PiecePrograms = std::array<AttackProgram, 128>;
+
+// Throws std::runtime_error on an unknown code or a malformed expression
+AttackProgram compile_moveset(const std::string& expr);
@@ -7,8 +7,22 @@
 #include <fstream>
 #include "magic.h"
 
+// ========== Bishop magics ==========
+// Entries index into the shared sliderAttacks array (see magic.h).
+extern const SliderMagic bishopMagics[64];
+#ifdef USE_PEXT
+extern const SliderPext bishopPext[64];
+#endif
+
 // Lookup bishop attacks (runtime)
-Bitboard bishop_attacks(int sq, Bitboard occ);
+inline Bitboard bishop_attacks(int sq, Bitboard occ) {
+#ifdef USE_PEXT
+    return slider_attacks(bishopPext[sq], occ);
+#else
+    return slider_attacks(bishopMagics[sq], occ);
+#endif
+}
 
-// Initialization (implemented in bishop.cpp)
-void init_bishop_magics();
+// Relevant occupancy mask and slow reference generator (used by magic_gen)
+Bitboard bishop_mask(int sq);
+Bitboard bishop_attacks_on_the_fly(int sq, Bitboard blockers);
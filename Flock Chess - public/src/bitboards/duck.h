@@ -1,14 +1,95 @@
 // duck.h
 #pragma once
 #include <cstdint>
+#include <array>
 #include <vector>
 #include <iostream>
 #include <filesystem>
 #include <fstream>
 #include "magic.h"
 
-// Lookup duck attacks using magic table
-Bitboard duck_attacks(int sq, Bitboard occ);
+// ================== Exact duck lookup ==================
+/*
+  The duck's rule along a diagonal reads squares past the first blocker and
+  the edge squares, so no interior-only magic mask can capture it. Instead
+  each of the two diagonals through the square is looked up whole,
+  kindergarten style:
+    1. multiplying (occ & line) by the A-file spread collects the line's
+       occupancy into the top byte, one bit per file (a diagonal has exactly
+       one square per file, so nothing carries);
+    2. duckLineAttacks[file][byte] holds the landing files for a duck on
+       that file of such a line (both directions, same rule as
+       duck_attacks_on_the_fly);
+    3. multiplying the landing files back by the spread and masking with the
+       line puts them on the board.
+  Files outside a short diagonal read as empty in step 1; any landing square
+  that results lies off the line and is masked away in step 3, exactly as the
+  on-the-fly rule stops at the edge.
+*/
+constexpr Bitboard DUCK_FILE_SPREAD = 0x0101010101010101ULL;
 
-// Initialization (implemented in duck.cpp)
-void init_duck_magics();
+// One line, files 0..7: landing files for a duck on `file` given `occ`
+constexpr uint8_t duck_line_attacks(int file, int occ) {
+    uint8_t attacks = 0;
+    for (int step = -1; step <= 1; step += 2) {
+        int f = file + step;
+        if (f < 0 || f > 7) continue;
+
+        if (!(occ & (1 << f))) {
+            // Adjacent is empty => slide, including the first blocker
+            for (; f >= 0 && f <= 7; f += step) {
+                attacks |= (uint8_t)(1 << f);
+                if (occ & (1 << f)) break;
+            }
+        } else {
+            // Adjacent is occupied => first empty square further along
+            for (f += step; f >= 0 && f <= 7; f += step) {
+                if (!(occ & (1 << f))) {
+                    attacks |= (uint8_t)(1 << f);
+                    break;
+                }
+            }
+        }
+    }
+    return attacks;
+}
+
+constexpr std::array<std::array<uint8_t, 256>, 8> make_duck_line_table() {
+    std::array<std::array<uint8_t, 256>, 8> table{};
+    for (int file = 0; file < 8; file++)
+        for (int occ = 0; occ < 256; occ++)
+            table[file][occ] = duck_line_attacks(file, occ);
+    return table;
+}
+
+// Full diagonal (dr == df) or anti-diagonal (dr == -df) through sq, sq included
+constexpr std::array<Bitboard, 64> make_duck_lines(int dr) {
+    std::array<Bitboard, 64> lines{};
+    for (int sq = 0; sq < 64; sq++) {
+        int r0 = sq / 8, f0 = sq % 8;
+        for (int k = -7; k <= 7; k++) {
+            int r = r0 + dr * k, f = f0 + k;
+            if (r >= 0 && r < 8 && f >= 0 && f < 8)
+                lines[sq] |= 1ULL << (r * 8 + f);
+        }
+    }
+    return lines;
+}
+
+inline constexpr auto duckLineAttacks = make_duck_line_table();
+inline constexpr auto duckDiagonals = make_duck_lines(1);
+inline constexpr auto duckAntiDiagonals = make_duck_lines(-1);
+
+inline Bitboard duck_line(int sq, Bitboard line, Bitboard occ) {
+    int lineOcc = (int)(((occ & line) * DUCK_FILE_SPREAD) >> 56);
+    return (duckLineAttacks[sq & 7][lineOcc] * DUCK_FILE_SPREAD) & line;
+}
+
+// Lookup duck attacks: exact for every occupancy, O(1)
+inline Bitboard duck_attacks(int sq, Bitboard occ) {
+    return duck_line(sq, duckDiagonals[sq], occ)
+         | duck_line(sq, duckAntiDiagonals[sq], occ);
+}
+
+// Slow reference generator (the rule the tables are built from)
+Bitboard duck_attacks_on_the_fly(int sq, Bitboard occ);
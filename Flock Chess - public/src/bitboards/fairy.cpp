@@ -0,0 +1,158 @@
+#include "fairy.h"
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+
+CompiledPiece fairyPieces[NUM_MOVESET_CODES];
+
+PieceMoves& PieceMoves::add(MoveKind kind, int dr, int df) {
+    atoms.push_back({ kind, dr, df });
+    return *this;
+}
+
+PieceMoves& PieceMoves::add_symmetric(MoveKind kind, int a, int b) {
+    const int steps[8][2] = {
+        {  a,  b }, {  a, -b }, { -a,  b }, { -a, -b },
+        {  b,  a }, {  b, -a }, { -b,  a }, { -b, -a }
+    };
+    for (const auto& s : steps) {
+        bool seen = false;
+        for (const MoveAtom& m : atoms)
+            seen |= m.kind == kind && m.dr == s[0] && m.df == s[1];
+        if (!seen)
+            add(kind, s[0], s[1]);
+    }
+    return *this;
+}
+
+// ======================================================
+// Compiler
+// ======================================================
+
+static bool on_board(int r, int f) {
+    return r >= 0 && r < 8 && f >= 0 && f < 8;
+}
+
+static CompiledRay compile_ray(const MoveAtom& m) {
+    CompiledRay r{};
+    r.kind = m.kind;
+    r.forward = m.dr * 8 + m.df > 0;
+    for (int sq = 0; sq < 64; sq++) {
+        int rr = sq / 8 + m.dr, ff = sq % 8 + m.df;
+        if (on_board(rr, ff))
+            r.behind[sq] = 1ULL << (rr * 8 + ff);
+        for (; on_board(rr, ff); rr += m.dr, ff += m.df)
+            r.ray[sq] |= 1ULL << (rr * 8 + ff);
+    }
+    return r;
+}
+
+// True when every one of the four unit steps (±a, ±b), (±b, ±a) is a rider
+static bool has_rider_set(const PieceMoves& moves, int a, int b) {
+    const int steps[4][2] = { { a, b }, { -b, a }, { -a, -b }, { b, -a } };
+    for (const auto& s : steps) {
+        bool found = std::any_of(moves.atoms.begin(), moves.atoms.end(), [&](const MoveAtom& m) {
+            return m.kind == MoveKind::Rider && m.dr == s[0] && m.df == s[1];
+        });
+        if (!found)
+            return false;
+    }
+    return true;
+}
+
+static bool is_unit_step(const MoveAtom& m, bool orthogonal) {
+    int adr = std::abs(m.dr), adf = std::abs(m.df);
+    return orthogonal ? adr + adf == 1 : (adr == 1 && adf == 1);
+}
+
+CompiledPiece compile_piece(const PieceMoves& moves) {
+    CompiledPiece p;
+    p.rookRider = has_rider_set(moves, 1, 0);
+    p.bishopRider = has_rider_set(moves, 1, 1);
+
+    for (const MoveAtom& m : moves.atoms) {
+        if (m.dr == 0 && m.df == 0)
+            throw std::invalid_argument("compile_piece: null step");
+
+        if (m.kind == MoveKind::Leaper) {
+            for (int sq = 0; sq < 64; sq++) {
+                int rr = sq / 8 + m.dr, ff = sq % 8 + m.df;
+                if (on_board(rr, ff))
+                    p.leaps[sq] |= 1ULL << (rr * 8 + ff);
+            }
+            continue;
+        }
+
+        // Covered by the rook/bishop magics
+        if (m.kind == MoveKind::Rider && p.rookRider && is_unit_step(m, true))
+            continue;
+        if (m.kind == MoveKind::Rider && p.bishopRider && is_unit_step(m, false))
+            continue;
+
+        p.rays.push_back(compile_ray(m));
+    }
+    return p;
+}
+
+Bitboard piece_attacks_on_the_fly(const PieceMoves& moves, int sq, Bitboard occ) {
+    Bitboard attacks = 0ULL;
+    for (const MoveAtom& m : moves.atoms) {
+        int rr = sq / 8 + m.dr, ff = sq % 8 + m.df;
+
+        if (m.kind == MoveKind::Leaper) {
+            if (on_board(rr, ff))
+                attacks |= 1ULL << (rr * 8 + ff);
+            continue;
+        }
+
+        for (; on_board(rr, ff); rr += m.dr, ff += m.df) {
+            Bitboard bit = 1ULL << (rr * 8 + ff);
+            if (m.kind == MoveKind::Rider)
+                attacks |= bit;
+            if (occ & bit) {
+                if (m.kind == MoveKind::Hopper && on_board(rr + m.dr, ff + m.df))
+                    attacks |= 1ULL << ((rr + m.dr) * 8 + ff + m.df);
+                break;
+            }
+        }
+    }
+    return attacks;
+}
+
+// ======================================================
+// Moveset codes (see var_moveset.txt)
+// ======================================================
+
+PieceMoves moveset_moves(int code) {
+    using K = MoveKind;
+    PieceMoves m;
+    switch (code) {
+    case 4:  return m.add(K::Rider, 0, -1);                 // left
+    case 5:  return m.add(K::Rider, 0, 1);                  // right
+    case 6:  return m.add(K::Rider, 1, 0);                  // up
+    case 7:  return m.add(K::Rider, -1, 0);                 // down
+    case 8:  return m.add(K::Rider, 1, -1);                 // diag left up
+    case 9:  return m.add(K::Rider, 1, 1);                  // diag right up
+    case 10: return m.add(K::Rider, -1, 1);                 // diag right down
+    case 11: return m.add(K::Rider, -1, -1);                // diag left down
+    case 12: return m.add_symmetric(K::Hopper, 1, 0);       // space jump
+    case 13: return m.add(K::Hopper, 1, 0).add(K::Hopper, -1, 0);
+    case 14: return m.add(K::Hopper, 0, -1).add(K::Hopper, 0, 1);
+    case 18: return m.add(K::Hopper, 1, 0);                 // space jump front
+    case 21: return m.add_symmetric(K::Leaper, 1, 3);       // large knight
+    case 22: return m.add_symmetric(K::Rider, 1, 0)         // large queen
+                      .add_symmetric(K::Rider, 1, 1)
+                      .add_symmetric(K::Leaper, 1, 3);
+    case 15:
+        throw std::invalid_argument("Moveset code 15 (parametric) needs a step description");
+    default:
+        throw std::invalid_argument("Moveset code " + std::to_string(code) + " is not a fairy code");
+    }
+}
+
+void init_fairy_tables() {
+    const int codes[] = { 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 18, 21, 22 };
+    for (int code : codes)
+        fairyPieces[code] = compile_piece(moveset_moves(code));
+}
@@ -0,0 +1,96 @@
+// fairy.h
+#pragma once
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "rook.h"
+#include "bishops.h"
+
+// ================== Movement descriptions ==================
+/*
+  Every fairy moveset code in var_moveset.txt is described as a list of
+  atoms, each one step vector (dr, df) from White's point of view (dr > 0
+  is towards rank 8, df > 0 towards the h-file) with one of three kinds:
+    Leaper  lands on sq + step, occupied or not;
+    Rider   repeats the step until the edge or the first occupied square
+            (that square included);
+    Hopper  repeats the step until the first occupied square (the hurdle)
+            and lands on the one square directly behind it.
+  compile_piece() turns a description into lookup tables once, at
+  init_attack_tables(): leapers fold into one 64-entry table, full rook or
+  bishop rider sets reuse the slider magics, and any other rider or hopper
+  direction gets a ray table answered with one bit scan.
+*/
+enum class MoveKind : uint8_t { Leaper, Rider, Hopper };
+
+struct MoveAtom {
+    MoveKind kind;
+    int dr;
+    int df;
+};
+
+struct PieceMoves {
+    std::vector<MoveAtom> atoms;
+
+    PieceMoves& add(MoveKind kind, int dr, int df);
+    // All eight (or four) reflections and rotations of (a, b)
+    PieceMoves& add_symmetric(MoveKind kind, int a, int b);
+};
+
+// ================== Compiled form ==================
+struct CompiledRay {
+    MoveKind kind;                        // Rider or Hopper
+    bool forward;                         // step raises the square index
+    std::array<Bitboard, 64> ray;         // squares reached from sq on an empty board
+    std::array<Bitboard, 64> behind;      // sq + step, or 0 off the board
+};
+
+struct CompiledPiece {
+    std::array<Bitboard, 64> leaps{};
+    bool rookRider = false;
+    bool bishopRider = false;
+    std::vector<CompiledRay> rays;
+};
+
+CompiledPiece compile_piece(const PieceMoves& moves);
+
+// With no blocker on the ray the scan falls through to the corner square
+// (h8 going forward, a1 going back), whose ray and behind entries in that
+// direction are empty, so the lookup needs no branch on the occupancy.
+inline Bitboard ray_attacks(const CompiledRay& r, int sq, Bitboard occ) {
+    Bitboard ray = r.ray[sq];
+    Bitboard blockers = ray & occ;
+    int hurdle = r.forward ? indexLSB(blockers | (1ULL << 63)) : indexMSB(blockers | 1ULL);
+
+    if (r.kind == MoveKind::Hopper)
+        return r.behind[hurdle];
+    return ray ^ r.ray[hurdle];           // up to and including the blocker
+}
+
+inline Bitboard piece_attacks(const CompiledPiece& p, int sq, Bitboard occ) {
+    Bitboard attacks = p.leaps[sq];
+    if (p.rookRider)   attacks |= rook_attacks(sq, occ);
+    if (p.bishopRider) attacks |= bishop_attacks(sq, occ);
+    for (const CompiledRay& r : p.rays)
+        attacks |= ray_attacks(r, sq, occ);
+    return attacks;
+}
+
+// Slow reference: walks the description square by square (used by tests)
+Bitboard piece_attacks_on_the_fly(const PieceMoves& moves, int sq, Bitboard occ);
+
+// ================== Moveset codes ==================
+constexpr int NUM_MOVESET_CODES = 23;     // codes 0..22
+
+// Description of a fairy code; throws for codes that are built in
+// (rook, knight, ...) or that need parameters the variant cannot give (15)
+PieceMoves moveset_moves(int code);
+
+// Compiled pieces for every fairy code, filled by init_attack_tables()
+extern CompiledPiece fairyPieces[NUM_MOVESET_CODES];
+void init_fairy_tables();
+
+template <int Code>
+inline Bitboard fairy_attacks(int sq, Bitboard occ) {
+    return piece_attacks(fairyPieces[Code], sq, occ);
+}
@@ -1,3 +1,39 @@
+// king.h
+#pragma once
+#include <array>
 #include "magic.h"
 
-Bitboard king_attacks(int sq, Bitboard occ);
+constexpr Bitboard king_mask(int sq) {
+    Bitboard bb = 0ULL;
+    int r = sq / 8;
+    int f = sq % 8;
+
+    for (int dr = -1; dr <= 1; dr++) {
+        for (int df = -1; df <= 1; df++) {
+            if (dr == 0 && df == 0) continue;
+
+            int rr = r + dr;
+            int ff = f + df;
+
+            if (rr >= 0 && rr < 8 && ff >= 0 && ff < 8)
+                bb |= 1ULL << (rr * 8 + ff);
+        }
+    }
+
+    return bb;
+}
+
+constexpr std::array<Bitboard, 64> make_king_attacks() {
+    std::array<Bitboard, 64> table{};
+    for (int sq = 0; sq < 64; sq++)
+        table[sq] = king_mask(sq);
+    return table;
+}
+
+// Built at compile time; no initialization needed before the first query
+inline constexpr std::array<Bitboard, 64> kingAttacks = make_king_attacks();
+
+inline Bitboard king_attacks(int sq, Bitboard occ) {
+    (void)occ; // king attacks also ignore occupancy
+    return kingAttacks[sq];
+}
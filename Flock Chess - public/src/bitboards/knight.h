@@ -1,5 +1,44 @@
 // knight.h
 #pragma once
+#include <array>
 #include "magic.h"
 
-Bitboard knight_attacks(int sq, Bitboard occ);
\ No newline at end of file
+constexpr int knightMoves[8][2] = {
+    {  2,  1 }, {  2, -1 },
+    { -2,  1 }, { -2, -1 },
+    {  1,  2 }, {  1, -2 },
+    { -1,  2 }, { -1, -2 }
+};
+
+constexpr Bitboard knight_mask(int sq) {
+    int r = sq / 8;
+    int f = sq % 8;
+
+    Bitboard attacks = 0ULL;
+
+    for (int i = 0; i < 8; i++) {
+        int rr = r + knightMoves[i][0];
+        int ff = f + knightMoves[i][1];
+
+        if (rr >= 0 && rr < 8 && ff >= 0 && ff < 8) {
+            attacks |= 1ULL << (rr * 8 + ff);
+        }
+    }
+
+    return attacks;
+}
+
+constexpr std::array<Bitboard, 64> make_knight_attacks() {
+    std::array<Bitboard, 64> table{};
+    for (int sq = 0; sq < 64; sq++)
+        table[sq] = knight_mask(sq);
+    return table;
+}
+
+// Built at compile time; no initialization needed before the first query
+inline constexpr std::array<Bitboard, 64> knightAttacks = make_knight_attacks();
+
+inline Bitboard knight_attacks(int sq, Bitboard occ) {
+    (void)occ; // knights jump; ignore occupancy
+    return knightAttacks[sq];
+}
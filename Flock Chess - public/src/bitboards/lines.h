@@ -0,0 +1,46 @@
+// lines.h
+#pragma once
+#include <array>
+#include "magic.h"
+
+// ================== Between / line tables ==================
+/*
+  betweenBB[a][b]  squares strictly between a and b when they share a rank,
+                   file or diagonal, else 0
+  lineBB[a][b]     the whole rank/file/diagonal through a and b (both
+                   included) when they share one, else 0
+  Used for check evasions (block or capture the checker) and pins (a pinned
+  piece stays on the line through its king and the pinner).
+*/
+using SquareTable = std::array<std::array<Bitboard, 64>, 64>;
+
+constexpr int line_sign(int x) { return (x > 0) - (x < 0); }
+
+constexpr SquareTable make_line_table(bool between) {
+    SquareTable table{};
+    for (int a = 0; a < 64; a++) {
+        for (int b = 0; b < 64; b++) {
+            int dr = b / 8 - a / 8, df = b % 8 - a % 8;
+            if (a == b || (dr != 0 && df != 0 && dr != df && dr != -df))
+                continue;
+            int sr = line_sign(dr), sf = line_sign(df);
+
+            if (between) {
+                for (int r = a / 8 + sr, f = a % 8 + sf; r * 8 + f != b; r += sr, f += sf)
+                    table[a][b] |= 1ULL << (r * 8 + f);
+                continue;
+            }
+            // Walk both ways from a to the edges
+            table[a][b] |= 1ULL << a;
+            for (int dir = -1; dir <= 1; dir += 2) {
+                int r = a / 8 + dir * sr, f = a % 8 + dir * sf;
+                for (; r >= 0 && r < 8 && f >= 0 && f < 8; r += dir * sr, f += dir * sf)
+                    table[a][b] |= 1ULL << (r * 8 + f);
+            }
+        }
+    }
+    return table;
+}
+
+inline constexpr SquareTable betweenBB = make_line_table(true);
+inline constexpr SquareTable lineBB = make_line_table(false);
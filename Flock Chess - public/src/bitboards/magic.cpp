@@ -1,4 +1,7 @@
 #include "magic.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
 
 // Enumerate all subsets of a mask
 inline Bitboard next_subset(Bitboard subset, Bitboard mask) {
@@ -7,84 +10,265 @@ inline Bitboard next_subset(Bitboard subset, Bitboard mask) {
 }
 
 // ======================================================
-// Random magic number generator (high entropy)
+// Deterministic candidate stream
 // ======================================================
+// Candidate k of a square is a pure function of (seed, square, k), so the
+// search result never depends on how many threads ran it or in what order
+// they finished: the winner is always the lowest candidate index that works.
 
-Bitboard random_magic() {
-    static std::mt19937_64 rng(0xC0FFEE123456789ULL);
+static inline uint64_t splitmix64(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+static inline Bitboard candidate_magic(uint64_t squareSeed, uint64_t k, bool dense) {
+    // Good magic numbers must have few bits set, hence the three-way AND.
+    // Dense tables need carries that fold whole groups of subsets into one
+    // slot, which sparse numbers rarely produce, so dense searches cycle
+    // through denser candidates as well.
+    int ands = dense ? (int)(k % 3) : 2;
 
-    // Good magic numbers must have few low bits — but this generator is
-    // already good enough for both rooks and bishops
-    Bitboard candidate = 0;
-    candidate = rng();
-    candidate &= rng();
-    candidate &= rng();
+    Bitboard candidate = splitmix64(squareSeed + 3 * k);
+    if (ands >= 1) candidate &= splitmix64(squareSeed + 3 * k + 1);
+    if (ands >= 2) candidate &= splitmix64(squareSeed + 3 * k + 2);
     return candidate;
 }
 
 // ======================================================
-// Core: find_magic()
-// mask = relevant occupancy mask
-// attacks(subset) = function that computes attacks for a given blocker subset
+// Per-square search state
 // ======================================================
 
-Bitboard find_magic(
-    int square,
-    Bitboard mask,
-    Bitboard (*attacks)(int, Bitboard),   // user-supplied attack generator
-    int &outShift,
-    std::vector<Bitboard> &outAttackTable
-) {
-    int relevantBits = popcount(mask);
-    int tableSize = 1 << relevantBits;
+namespace {
 
-    // Temporary buffer for testing collisions
-    std::vector<Bitboard> used(tableSize);
+constexpr uint64_t NO_MAGIC = ~0ULL;
+constexpr uint64_t BATCH = 256;     // candidates a thread claims at a time
+
+struct SquareSearch {
+    int square = 0;
+    Bitboard mask = 0ULL;
+    uint64_t seed = 0;
+    int shift = 0;
+    bool dense = false;             // shift is above 64 - relevantBits
+    uint64_t limit = NO_MAGIC;      // candidates to try before giving up
 
-    // Precompute subsets
     std::vector<Bitboard> subsets;
     std::vector<Bitboard> moves;
-    subsets.reserve(tableSize);
-    moves.reserve(tableSize);
+
+    std::atomic<uint64_t> nextBatch{0};
+    std::atomic<uint64_t> best{NO_MAGIC};   // lowest working candidate index
+
+    Bitboard candidate(uint64_t k) const { return candidate_magic(seed, k, dense); }
+
+    // True while some batch below the current best is still unclaimed
+    bool has_work() const {
+        uint64_t first = nextBatch.load(std::memory_order_relaxed) * BATCH;
+        return first < best.load(std::memory_order_relaxed) && first < limit;
+    }
+};
+
+// Scratch table reused across candidates; a slot is only valid when its stamp
+// matches the current attempt, which avoids clearing the table every time and
+// lets an empty attack set count as a real value.
+struct Scratch {
+    std::vector<Bitboard> used;
+    std::vector<uint32_t> stamp;
+    uint32_t attempt = 0;
+};
+
+} // namespace
+
+static bool try_magic(const SquareSearch& s, Bitboard magic, Scratch& scratch) {
+    // Magic numbers must satisfy this heuristic (used by Glaurung/Stockfish).
+    // Dense searches skip it: their index is narrower than the top byte.
+    if (!s.dense && popcount((magic * s.mask) & 0xFF00000000000000ULL) < 6)
+        return false;
+
+    if (++scratch.attempt == 0) {
+        std::fill(scratch.stamp.begin(), scratch.stamp.end(), 0u);
+        scratch.attempt = 1;
+    }
+
+    for (size_t i = 0; i < s.subsets.size(); i++) {
+        size_t idx = (size_t)((s.subsets[i] * magic) >> s.shift);
+
+        if (scratch.stamp[idx] != scratch.attempt) {
+            scratch.stamp[idx] = scratch.attempt;
+            scratch.used[idx] = s.moves[i];
+        } else if (scratch.used[idx] != s.moves[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void search_batch(SquareSearch& s, uint64_t batch, Scratch& scratch) {
+    size_t tableSize = size_t(1) << (64 - s.shift);
+    if (scratch.used.size() < tableSize) {
+        scratch.used.resize(tableSize);
+        scratch.stamp.resize(tableSize, 0u);
+    }
+
+    uint64_t first = batch * BATCH;
+    uint64_t last = std::min(first + BATCH, s.limit);
+
+    for (uint64_t k = first; k < last; k++) {
+        if (k >= s.best.load(std::memory_order_relaxed))
+            return;
+        if (!try_magic(s, s.candidate(k), scratch))
+            continue;
+
+        uint64_t cur = s.best.load(std::memory_order_relaxed);
+        while (k < cur && !s.best.compare_exchange_weak(cur, k)) {}
+        return;
+    }
+}
+
+// All threads work the lowest-numbered square that still has unclaimed
+// batches below its best candidate, then move on. Easy squares are done by
+// whichever thread gets there first; hard ones get every core.
+static void run_searches(std::vector<SquareSearch>& searches, int threads) {
+    auto worker = [&searches]() {
+        Scratch scratch;
+        size_t cursor = 0;
+        while (cursor < searches.size()) {
+            SquareSearch& s = searches[cursor];
+            if (!s.has_work()) {
+                cursor++;
+                continue;
+            }
+            uint64_t batch = s.nextBatch.fetch_add(1, std::memory_order_relaxed);
+            if (batch * BATCH < s.limit)
+                search_batch(s, batch, scratch);
+        }
+    };
+
+    if (threads <= 1) {
+        worker();
+        return;
+    }
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; t++)
+        pool.emplace_back(worker);
+    for (auto& th : pool)
+        th.join();
+}
+
+static void prepare_search(SquareSearch& s, int square, Bitboard mask,
+                           Bitboard (*attacks)(int, Bitboard), uint64_t seed) {
+    s.square = square;
+    s.mask = mask;
+    s.seed = splitmix64(seed ^ (uint64_t(square + 1) * 0x9E3779B97F4A7C15ULL));
+
+    size_t tableSize = size_t(1) << popcount(mask);
+    s.subsets.reserve(tableSize);
+    s.moves.reserve(tableSize);
 
     Bitboard subset = mask;
     do {
-        subsets.push_back(subset);
-        moves.push_back(attacks(square, subset));
-        subset = (subset - 1) & mask;
+        s.subsets.push_back(subset);
+        s.moves.push_back(attacks(square, subset));
+        subset = next_subset(subset, mask);
     } while (subset != mask); // stops after subset==0 has been processed
+}
 
-    // We want shift = 64 - relevantBits
-    int shift = 64 - relevantBits;
+static void fill_table(const SquareSearch& s, Bitboard magic, std::vector<Bitboard>& table) {
+    table.assign(size_t(1) << (64 - s.shift), 0ULL);
+    for (size_t i = 0; i < s.subsets.size(); i++)
+        table[(size_t)((s.subsets[i] * magic) >> s.shift)] = s.moves[i];
+}
 
-    // Try random magics until one works
-    while (true) {
-        Bitboard magic = random_magic();
+// ======================================================
+// Core: find_magics()
+// ======================================================
 
-        // Magic numbers must satisfy this heuristic (used by Glaurung/Stockfish):
-        if (popcount((magic * mask) & 0xFF00000000000000ULL) < 6)
-            continue;
+void find_magics(
+    Bitboard (*mask)(int),
+    Bitboard (*attacks)(int, Bitboard),
+    const MagicSearch& opts,
+    MagicResult out[64]
+) {
+    int threads = opts.threads > 0 ? opts.threads
+                                   : (int)std::max(1u, std::thread::hardware_concurrency());
 
-        std::fill(used.begin(), used.end(), 0ULL);
-        bool failed = false;
+    // Pass 1: the classic shift = 64 - relevantBits, which always succeeds.
+    std::vector<SquareSearch> searches(64);
+    for (int sq = 0; sq < 64; sq++) {
+        prepare_search(searches[sq], sq, mask(sq), attacks, opts.seed);
+        searches[sq].shift = 64 - popcount(searches[sq].mask);
+    }
+    run_searches(searches, threads);
 
-        for (int i = 0; i < tableSize; i++) {
-            Bitboard occ = subsets[i];
-            int idx = (int)((occ * magic) >> shift);
+    for (int sq = 0; sq < 64; sq++) {
+        const SquareSearch& s = searches[sq];
+        out[sq].mask = s.mask;
+        out[sq].magic = s.candidate(s.best);
+        out[sq].shift = s.shift;
+        fill_table(s, out[sq].magic, out[sq].attacks);
+    }
 
-            if (used[idx] == 0ULL)
-                used[idx] = moves[i];
-            else if (used[idx] != moves[i]) {
-                failed = true;
-                break;
-            }
+    // Dense passes: keep shrinking each square's table by one bit while a
+    // magic with constructive collisions turns up within the budget.
+    if (!opts.dense)
+        return;
+
+    std::vector<int> open;
+    for (int sq = 0; sq < 64; sq++)
+        if (popcount(out[sq].mask) > 1)
+            open.push_back(sq);
+
+    while (!open.empty()) {
+        std::vector<SquareSearch> dense(open.size());
+        for (size_t i = 0; i < open.size(); i++) {
+            int sq = open[i];
+            dense[i].square = sq;
+            dense[i].mask = searches[sq].mask;
+            dense[i].seed = splitmix64(searches[sq].seed ^ (uint64_t)out[sq].shift);
+            dense[i].subsets = searches[sq].subsets;
+            dense[i].moves = searches[sq].moves;
+            dense[i].shift = out[sq].shift + 1;
+            dense[i].dense = true;
+            dense[i].limit = opts.denseBudget;
         }
+        run_searches(dense, threads);
 
-        if (!failed) {
-            // Found a good magic!
-            outShift = shift;
-            outAttackTable = used;
-            return magic;
+        std::vector<int> still;
+        for (size_t i = 0; i < open.size(); i++) {
+            const SquareSearch& s = dense[i];
+            if (s.best == NO_MAGIC)
+                continue;
+            MagicResult& r = out[s.square];
+            r.magic = s.candidate(s.best);
+            r.shift = s.shift;
+            fill_table(s, r.magic, r.attacks);
+            if (64 - r.shift > 1)
+                still.push_back(s.square);
         }
+        open.swap(still);
     }
 }
+
+// ======================================================
+// Single-square convenience wrapper
+// mask = relevant occupancy mask
+// attacks(subset) = function that computes attacks for a given blocker subset
+// ======================================================
+
+Bitboard find_magic(
+    int square,
+    Bitboard mask,
+    Bitboard (*attacks)(int, Bitboard),   // user-supplied attack generator
+    int &outShift,
+    std::vector<Bitboard> &outAttackTable
+) {
+    std::vector<SquareSearch> searches(1);
+    prepare_search(searches[0], square, mask, attacks, MagicSearch{}.seed);
+    searches[0].shift = 64 - popcount(mask);
+    run_searches(searches, 1);
+
+    Bitboard magic = searches[0].candidate(searches[0].best);
+    outShift = searches[0].shift;
+    fill_table(searches[0], magic, outAttackTable);
+    return magic;
+}
@@ -8,8 +8,38 @@
 #include "bitutils.h"
 
 // =====================================================
-// Shared magic function used by all sliding pieces
+// Magic search shared by all sliding pieces
 // =====================================================
+struct MagicSearch {
+    uint64_t seed = 0xC0FFEE123456789ULL;   // per-square streams derive from this
+    int threads = 0;                        // 0 = one per hardware thread
+    bool dense = false;                     // also look for smaller tables
+    uint64_t denseBudget = 1ULL << 20;      // candidates per square per extra bit
+};
+
+struct MagicResult {
+    Bitboard mask;
+    Bitboard magic;
+    int shift;
+    std::vector<Bitboard> attacks;
+};
+
+// Finds magics for all 64 squares of one slider, spreading squares and
+// candidate batches over opts.threads threads. The result depends only on
+// opts (never on the thread count or scheduling).
+//
+// Plain mode uses shift = 64 - relevantBits. Dense mode then keeps raising
+// the shift one bit at a time for every square where a magic with only
+// constructive collisions (same attack set in the same slot) turns up within
+// denseBudget candidates.
+void find_magics(
+    Bitboard (*mask)(int),
+    Bitboard (*attacks)(int, Bitboard),
+    const MagicSearch& opts,
+    MagicResult out[64]
+);
+
+// Single square, single thread, plain mode
 Bitboard find_magic(
     int square,
     Bitboard mask,
@@ -17,3 +47,47 @@ Bitboard find_magic(
     int &outShift,
     std::vector<Bitboard> &outAttackTable
 );
+
+// =====================================================
+// Fancy magic layout
+// =====================================================
+// Every slider square owns a slice of one flat attack array. The per-square
+// entry is 24 bytes, so a piece's 64 entries fill 24 cache lines and a
+// lookup is one entry load plus one table load, with no pointer chase.
+struct SliderMagic {
+    Bitboard mask;
+    Bitboard magic;
+    uint32_t offset;    // first slot of this square in sliderAttacks
+    uint32_t shift;
+};
+static_assert(sizeof(SliderMagic) == 24, "SliderMagic must stay 24 bytes");
+
+// Generated at build time by magic_gen (magic_tables.cpp in the build tree)
+extern const Bitboard sliderAttacks[];
+extern const uint32_t sliderAttacksSize;
+
+inline Bitboard slider_attacks(const SliderMagic& M, Bitboard occ) {
+    return sliderAttacks[M.offset + (((occ & M.mask) * M.magic) >> M.shift)];
+}
+
+// =====================================================
+// PEXT layout (FLOCK_USE_PEXT builds only)
+// =====================================================
+// Same idea without the multiply: PEXT over the mask is a collision-free
+// index, so each square owns exactly 2^popcount(mask) slots of its own flat
+// array. 16 bytes per square.
+struct SliderPext {
+    Bitboard mask;
+    uint32_t offset;    // first slot of this square in sliderPextAttacks
+    uint32_t size;
+};
+static_assert(sizeof(SliderPext) == 16, "SliderPext must stay 16 bytes");
+
+#ifdef USE_PEXT
+extern const Bitboard sliderPextAttacks[];
+extern const uint32_t sliderPextAttacksSize;
+
+inline Bitboard slider_attacks(const SliderPext& P, Bitboard occ) {
+    return sliderPextAttacks[P.offset + pext(occ, P.mask)];
+}
+#endif
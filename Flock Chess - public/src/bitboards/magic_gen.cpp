@@ -0,0 +1,172 @@
+// magic_gen.cpp
+// Build-time generator for the slider magic tables.
+//
+// Runs find_magics() for every square of the rook and bishop and writes
+// the per-square magic entries plus one flat attack array (see SliderMagic
+// in magic.h) out as a C++ source file of static const data. CMake runs this
+// once and compiles the output into the bitboards library, so the engine
+// does no magic search and no file I/O at startup. FLOCK_USE_PEXT builds
+// also get PEXT-indexed tables (see SliderPext in magic.h).
+//
+// Usage: magic_gen [--threads N] [--dense] [--dense-budget N] <output.cpp>
+//   --threads N        search threads (default: one per hardware thread)
+//   --dense            also search for smaller tables (see find_magics)
+//   --dense-budget N   candidates per square per extra bit in dense mode
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "rook.h"
+#include "bishops.h"
+
+struct SliderSpec {
+    const char* name;                      // prefix of the emitted magics array
+    Bitboard (*mask)(int);
+    Bitboard (*attacks)(int, Bitboard);
+};
+
+struct SliderResult {
+    Bitboard mask[64];
+    Bitboard magic[64];
+    int shift[64];
+    uint32_t offset[64];
+    uint32_t pextOffset[64];
+    uint32_t pextSize[64];
+};
+
+// Searches all 64 squares of one slider and appends each square's table to
+// the shared flat array.
+static void search_slider(const SliderSpec& spec, const MagicSearch& opts,
+                          SliderResult& out, std::vector<Bitboard>& flat) {
+    std::vector<MagicResult> found(64);
+    find_magics(spec.mask, spec.attacks, opts, found.data());
+
+    for (int sq = 0; sq < 64; sq++) {
+        out.mask[sq] = found[sq].mask;
+        out.magic[sq] = found[sq].magic;
+        out.shift[sq] = found[sq].shift;
+        out.offset[sq] = (uint32_t)flat.size();
+        flat.insert(flat.end(), found[sq].attacks.begin(), found[sq].attacks.end());
+    }
+}
+
+#ifdef USE_PEXT
+// PEXT tables need no search: every subset of the mask has its own slot.
+static void build_pext(const SliderSpec& spec, SliderResult& out, std::vector<Bitboard>& flat) {
+    for (int sq = 0; sq < 64; sq++) {
+        Bitboard mask = out.mask[sq];
+        out.pextOffset[sq] = (uint32_t)flat.size();
+        out.pextSize[sq] = 1u << popcount(mask);
+        flat.resize(flat.size() + out.pextSize[sq]);
+
+        Bitboard subset = mask;
+        do {
+            flat[out.pextOffset[sq] + pext_soft(subset, mask)] = spec.attacks(sq, subset);
+            subset = (subset - 1) & mask;
+        } while (subset != mask);
+    }
+}
+#endif
+
+static void emit_magics(std::ostream& out, const SliderSpec& spec, const SliderResult& r) {
+    out << "alignas(64) const SliderMagic " << spec.name << "Magics[64] = {\n";
+    for (int sq = 0; sq < 64; sq++) {
+        out << "    { 0x" << std::hex << r.mask[sq] << "ull, 0x" << r.magic[sq]
+            << std::dec << "ull, " << r.offset[sq] << ", " << r.shift[sq] << " },\n";
+    }
+    out << "};\n\n";
+}
+
+#ifdef USE_PEXT
+static void emit_pext(std::ostream& out, const SliderSpec& spec, const SliderResult& r) {
+    out << "alignas(64) const SliderPext " << spec.name << "Pext[64] = {\n";
+    for (int sq = 0; sq < 64; sq++) {
+        out << "    { 0x" << std::hex << r.mask[sq] << std::dec << "ull, "
+            << r.pextOffset[sq] << ", " << r.pextSize[sq] << " },\n";
+    }
+    out << "};\n\n";
+}
+#endif
+
+static void emit_table(std::ostream& out, const char* name, const std::vector<Bitboard>& flat) {
+    out << "const uint32_t " << name << "Size = " << flat.size() << ";\n\n";
+    out << "alignas(64) const Bitboard " << name << "[" << flat.size() << "] = {";
+    for (size_t i = 0; i < flat.size(); ++i) {
+        if (i % 6 == 0) out << "\n   ";
+        out << " 0x" << std::hex << flat[i] << std::dec << "ull,";
+    }
+    out << "\n};\n\n";
+}
+
+int main(int argc, char* argv[]) {
+    MagicSearch opts;
+    std::string path;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--threads" && i + 1 < argc)
+            opts.threads = std::stoi(argv[++i]);
+        else if (arg == "--dense")
+            opts.dense = true;
+        else if (arg == "--dense-budget" && i + 1 < argc)
+            opts.denseBudget = std::stoull(argv[++i]);
+        else if (path.empty() && arg[0] != '-')
+            path = arg;
+        else
+            path.clear(), i = argc;
+    }
+    if (path.empty()) {
+        std::cerr << "Usage: magic_gen [--threads N] [--dense] [--dense-budget N] <output.cpp>\n";
+        return 1;
+    }
+
+    std::ofstream out(path);
+    if (!out.is_open()) {
+        std::cerr << "magic_gen: cannot open " << path << "\n";
+        return 1;
+    }
+
+    out << "// Generated by magic_gen. Do not edit.\n"
+        << "#include \"rook.h\"\n"
+        << "#include \"bishops.h\"\n\n";
+
+    const SliderSpec sliders[] = {
+        { "rook",   rook_mask,   rook_attacks_on_the_fly },
+        { "bishop", bishop_mask, bishop_attacks_on_the_fly },
+    };
+    const int numSliders = sizeof(sliders) / sizeof(sliders[0]);
+
+    auto t0 = std::chrono::steady_clock::now();
+    std::vector<Bitboard> flat;
+    std::vector<SliderResult> results(numSliders);
+    for (int i = 0; i < numSliders; i++)
+        search_slider(sliders[i], opts, results[i], flat);
+
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    std::cout << "magic_gen: " << flat.size() << " attack slots ("
+              << flat.size() * sizeof(Bitboard) << " bytes) in " << secs << " s"
+              << (opts.dense ? ", dense mode\n" : "\n");
+
+    for (int i = 0; i < numSliders; i++)
+        emit_magics(out, sliders[i], results[i]);
+
+    emit_table(out, "sliderAttacks", flat);
+
+#ifdef USE_PEXT
+    std::vector<Bitboard> pextFlat;
+    for (int i = 0; i < numSliders; i++) {
+        build_pext(sliders[i], results[i], pextFlat);
+        emit_pext(out, sliders[i], results[i]);
+    }
+    emit_table(out, "sliderPextAttacks", pextFlat);
+#endif
+
+    out.close();
+    if (!out) {
+        std::cerr << "magic_gen: failed writing " << path << "\n";
+        return 1;
+    }
+    return 0;
+}
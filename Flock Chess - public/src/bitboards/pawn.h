@@ -1,4 +1,92 @@
+// pawn.h
+#pragma once
+#include <array>
 #include "magic.h"
 
-Bitboard white_pawn_attacks(int sq, Bitboard occ);
-Bitboard black_pawn_attacks(int sq, Bitboard occ);
+// A helper that generates a single pawn's attacks given a square
+constexpr Bitboard white_pawn_mask(int sq) {
+    Bitboard bb = 0ULL;
+    int r = sq / 8;
+    int f = sq % 8;
+
+    if (r == 7) return 0ULL; // white pawns cannot exist on rank 8 theoretically
+
+    if (f > 0)     bb |= 1ULL << (sq + 7); // up-left
+    if (f < 7)     bb |= 1ULL << (sq + 9); // up-right
+
+    return bb;
+}
+
+constexpr Bitboard black_pawn_mask(int sq) {
+    Bitboard bb = 0ULL;
+    int r = sq / 8;
+    int f = sq % 8;
+
+    if (r == 0) return 0ULL; // black pawns cannot exist on rank 1 theoretically
+
+    if (f > 0)     bb |= 1ULL << (sq - 9); // down-left
+    if (f < 7)     bb |= 1ULL << (sq - 7); // down-right
+
+    return bb;
+}
+
+constexpr std::array<Bitboard, 64> make_pawn_attacks(Bitboard (*mask)(int)) {
+    std::array<Bitboard, 64> table{};
+    for (int sq = 0; sq < 64; sq++)
+        table[sq] = mask(sq);
+    return table;
+}
+
+// Built at compile time; no initialization needed before the first query
+inline constexpr std::array<Bitboard, 64> whitePawnAttacks = make_pawn_attacks(white_pawn_mask);
+inline constexpr std::array<Bitboard, 64> blackPawnAttacks = make_pawn_attacks(black_pawn_mask);
+
+// Query functions
+inline Bitboard white_pawn_attacks(int sq, Bitboard occ) {
+    (void)occ;  // ignored — pawn attacks do NOT depend on occupancy
+    return whitePawnAttacks[sq];
+}
+
+inline Bitboard black_pawn_attacks(int sq, Bitboard occ) {
+    (void)occ;
+    return blackPawnAttacks[sq];
+}
+
+// ================== Set-wise pawn moves ==================
+/*
+  Every pawn of one side at once: each helper maps the set of pawns to the
+  set of squares they reach, and the mover's square is to - offset with
+  the offset returned by the matching *_offset(). Blockers are whatever the
+  caller leaves out of `empty`, neutral pieces such as ducks included.
+*/
+constexpr Bitboard FILE_A_BB = 0x0101010101010101ULL;
+constexpr Bitboard FILE_H_BB = FILE_A_BB << 7;
+constexpr Bitboard RANK_1_BB = 0xFFULL;
+constexpr Bitboard RANK_3_BB = RANK_1_BB << 16;
+constexpr Bitboard RANK_6_BB = RANK_1_BB << 40;
+constexpr Bitboard RANK_8_BB = RANK_1_BB << 56;
+
+constexpr int pawn_push_offset(bool white) { return white ? 8 : -8; }
+constexpr int pawn_west_offset(bool white) { return white ? 7 : -9; }    // towards the a-file
+constexpr int pawn_east_offset(bool white) { return white ? 9 : -7; }    // towards the h-file
+
+constexpr Bitboard pawn_pushes(Bitboard pawns, Bitboard empty, bool white) {
+    return (white ? pawns << 8 : pawns >> 8) & empty;
+}
+
+// Two-square pushes, from the single pushes that landed on the third rank
+constexpr Bitboard pawn_double_pushes(Bitboard pushes, Bitboard empty, bool white) {
+    return pawn_pushes(pushes & (white ? RANK_3_BB : RANK_6_BB), empty, white);
+}
+
+constexpr Bitboard pawn_west_attacks(Bitboard pawns, bool white) {
+    return (white ? pawns << 7 : pawns >> 9) & ~FILE_H_BB;
+}
+
+constexpr Bitboard pawn_east_attacks(Bitboard pawns, bool white) {
+    return (white ? pawns << 9 : pawns >> 7) & ~FILE_A_BB;
+}
+
+constexpr Bitboard pawn_promotion_rank(bool white) {
+    return white ? RANK_8_BB : RANK_1_BB;
+}
@@ -1,4 +1,3 @@
-#pragma once
 #include "rook.h"
 
 // ================== Rook Directions ==================
@@ -53,134 +52,3 @@ Bitboard rook_attacks_on_the_fly(int sq, Bitboard blockers) {
 
     return attacks;
 }
-
-// ================== Rook Magic structure ==================
-struct RookMagic {
-    Bitboard mask;
-    Bitboard magic;
-    int shift;
-    std::vector<Bitboard> attacks;
-};
-
-RookMagic rookMagics[64];
-
-void print_rook_magic_constants() {
-    std::cout << "static const RookMagic rookMagics[64] = {\n";
-
-    for (int sq = 0; sq < 64; ++sq) {
-        const RookMagic &M = rookMagics[sq];
-
-        std::cout << "  {\n";
-
-        // mask
-        std::cout << "    0x" << std::hex << M.mask << "ull,\n";
-
-        // magic
-        std::cout << "    0x" << std::hex << M.magic << "ull,\n";
-
-        // shift
-        std::cout << "    " << std::dec << M.shift << ",\n";
-
-        // attacks vector
-        std::cout << "    {";
-        for (size_t i = 0; i < M.attacks.size(); ++i) {
-            std::cout << " 0x" << std::hex << M.attacks[i] << "ull";
-            if (i + 1 != M.attacks.size()) std::cout << ",";
-        }
-        std::cout << " }\n";
-
-        std::cout << "  }";
-        if (sq != 63) std::cout << ",";
-        std::cout << "\n";
-    }
-
-    std::cout << "};\n";
-}
-
-bool write_rook_magics_to_file(const std::string& filename) {
-    std::ofstream out(filename, std::ios::binary);
-    if (!out.is_open()) {
-        return false;
-    }
-    for (int sq = 0; sq < 64; ++sq) {
-        RookMagic &M = rookMagics[sq];
-
-        out.write((char*)&M.mask, sizeof(M.mask));
-        out.write((char*)&M.magic, sizeof(M.magic));
-        out.write((char*)&M.shift, sizeof(M.shift));
-
-        uint64_t size = M.attacks.size();
-        out.write((char*)&size, sizeof(size));
-        out.write((char*)M.attacks.data(), size * sizeof(Bitboard));
-    }
-    out.close();
-    return true;
-}
-
-// ================== Initialize rook magics ==================
-void init_rook_magics() {
-    for (int sq = 0; sq < 64; sq++) {
-        RookMagic &M = rookMagics[sq];
-
-        M.mask = rook_mask(sq);
-
-        // Build magic table
-        M.magic = find_magic(
-            sq,
-            M.mask,
-            rook_attacks_on_the_fly,
-            M.shift,
-            M.attacks
-        );
-    }
-    std::string filename = "rookMagics.bin";
-    if (!write_rook_magics_to_file(filename)) {
-        std::cout << "Failed to write rook magics to file!\n";
-    }
-}
-
-inline bool file_exists(const std::string& filename) {
-    std::ifstream in_r(filename, std::ios::binary);
-    bool b = in_r.good();
-    in_r.close();
-    return in_r.good();
-}
-
-bool read_rook_magics_from_file(const std::string& filename) {
-    if (!file_exists(filename)) {
-        return false;
-    }
-    std::ifstream in(filename, std::ios::binary);
-    for (int sq = 0; sq < 64; ++sq) {
-        RookMagic &M = rookMagics[sq];
-
-        in.read((char*)&M.mask, sizeof(M.mask));
-        in.read((char*)&M.magic, sizeof(M.magic));
-        in.read((char*)&M.shift, sizeof(M.shift));
-
-        uint64_t size;
-        in.read((char*)&size, sizeof(size));
-        M.attacks.resize(size);
-        in.read((char*)M.attacks.data(), size * sizeof(Bitboard));
-    }
-    in.close();
-    return true;
-}
-
-// ================== Query function ==================
-Bitboard rook_attacks(int sq, Bitboard occ) {
-    std::string filename = "rookMagics.bin";
-
-    if (!file_exists(filename)) {
-        // std::cout << "File does not exist, creating it...\n";
-        init_rook_magics();
-    }
-    if (!read_rook_magics_from_file(filename)) {
-        std::cout << "Failed to read rook magics from file!\n";
-        return 0ULL;
-    }
-    const RookMagic &M = rookMagics[sq];
-    Bitboard blockers = occ & M.mask;
-    Bitboard index = (blockers * M.magic) >> M.shift;
-    return M.attacks[index];
-}
\ No newline at end of file
@@ -7,7 +7,22 @@
 #include <fstream>
 #include "magic.h"
 
-Bitboard rook_attacks(int sq, Bitboard occ);
+// ================== Rook magics ==================
+// Entries index into the shared sliderAttacks array (see magic.h).
+extern const SliderMagic rookMagics[64];
+#ifdef USE_PEXT
+extern const SliderPext rookPext[64];
+#endif
 
-// Initialization (implemented in rook.cpp)
-void init_rook_magics();
\ No newline at end of file
+// ================== Query function ==================
+inline Bitboard rook_attacks(int sq, Bitboard occ) {
+#ifdef USE_PEXT
+    return slider_attacks(rookPext[sq], occ);
+#else
+    return slider_attacks(rookMagics[sq], occ);
+#endif
+}
+
+// Relevant occupancy mask and slow reference generator (used by magic_gen)
+Bitboard rook_mask(int sq);
+Bitboard rook_attacks_on_the_fly(int sq, Bitboard blockers);
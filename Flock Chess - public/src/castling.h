@@ -0,0 +1,66 @@
+// castling.h
+#pragma once
+#include "movegen.h"
+#include "move.h"
+#include "bitboards/lines.h"
+
+// =====================================================
+// Castling paths
+// =====================================================
+/*
+  One entry per CastlingRight, in bit order (K Q k q), all built at
+  compile time:
+    empty  squares that must hold no piece at all, neutral ones included:
+           everything between king and rook plus both landing squares
+    safe   squares the king crosses or lands on; with the king not in
+           check, none of them may be attacked
+  Rights themselves are updated in make_move through castlingMasks: a move
+  from or to a king or rook home square drops the rights that need it.
+*/
+struct CastlingPath {
+    uint8_t right;              // CastlingRight bit
+    MoveType type;              // CASTLE_KING or CASTLE_QUEEN
+    uint8_t kingFrom, kingTo;
+    uint8_t rookFrom, rookTo;
+    Bitboard empty;
+    Bitboard safe;
+};
+
+constexpr CastlingPath make_castling_path(int index) {
+    bool white = index < 2, kingSide = index % 2 == 0;
+    int home = white ? 4 : 60;
+    CastlingPath c{};
+    c.right = static_cast<uint8_t>(1 << index);
+    c.type = kingSide ? CASTLE_KING : CASTLE_QUEEN;
+    c.kingFrom = static_cast<uint8_t>(home);
+    c.kingTo = static_cast<uint8_t>(kingSide ? home + 2 : home - 2);
+    c.rookFrom = static_cast<uint8_t>(kingSide ? home + 3 : home - 4);
+    c.rookTo = static_cast<uint8_t>(kingSide ? home + 1 : home - 1);
+
+    Bitboard ends = (1ULL << c.kingFrom) | (1ULL << c.rookFrom);
+    c.empty = (betweenBB[c.kingFrom][c.rookFrom] | (1ULL << c.kingTo) | (1ULL << c.rookTo)) & ~ends;
+    c.safe = betweenBB[c.kingFrom][c.kingTo] | (1ULL << c.kingTo);
+    return c;
+}
+
+inline constexpr std::array<CastlingPath, 4> castlingPaths = {
+    make_castling_path(0), make_castling_path(1), make_castling_path(2), make_castling_path(3)
+};
+
+// Path of a castling move by the side whose king stands on `kingFrom`
+inline const CastlingPath& castling_path(MoveType type, int kingFrom) {
+    return castlingPaths[(kingFrom >= 32 ? 2 : 0) + (type == CASTLE_QUEEN)];
+}
+
+// Rights that survive a move touching each square
+constexpr std::array<uint8_t, 64> make_castling_masks() {
+    std::array<uint8_t, 64> masks{};
+    for (auto& m : masks) m = 0xF;
+    for (const CastlingPath& c : castlingPaths) {
+        masks[c.kingFrom] &= static_cast<uint8_t>(~c.right & 0xF);
+        masks[c.rookFrom] &= static_cast<uint8_t>(~c.right & 0xF);
+    }
+    return masks;
+}
+
+inline constexpr std::array<uint8_t, 64> castlingMasks = make_castling_masks();
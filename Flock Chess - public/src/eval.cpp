@@ -0,0 +1,70 @@
+#include "eval.h"
+#include <cctype>
+
+// Distance-to-edge bonus, 0 on the rim and 6 in the centre
+static constexpr std::array<int, 64> make_centrality() {
+    std::array<int, 64> table{};
+    for (int sq = 0; sq < 64; sq++) {
+        int r = sq / 8, f = sq % 8;
+        int dr = r < 4 ? r : 7 - r, df = f < 4 ? f : 7 - f;
+        table[sq] = 2 * (dr < df ? dr : df) + (dr + df) / 2;
+    }
+    return table;
+}
+static constexpr std::array<int, 64> centrality = make_centrality();
+
+static int standard_value(char upper) {
+    switch (upper) {
+    case 'P': return 100;
+    case 'N': return 320;
+    case 'B': return 330;
+    case 'R': return 500;
+    case 'Q': return 900;
+    default:  return -1;
+    }
+}
+
+Evaluator make_evaluator(const Bitboards& bb, const GameRules& rules) {
+    Evaluator ev;
+    for (int id = 0; id < bb.numPieces; id++) {
+        char letter = bb.pieceChar[id];
+        char upper = static_cast<char>(std::toupper(static_cast<unsigned char>(letter)));
+        const AttackProgram* program = rules.programs ? &(*rules.programs)[static_cast<unsigned char>(letter)] : nullptr;
+
+        ev.king[id] = upper == 'K';
+        ev.pawn[id] = upper == 'P' || (program && program->pawn);
+        if (ev.king[id] || ((bb.neutralTypes >> id) & 1))
+            continue;
+        if (ev.pawn[id]) {
+            ev.value[id] = 100;
+            continue;
+        }
+
+        int known = standard_value(upper);
+        if (known >= 0 || !program || program->count == 0) {
+            ev.value[id] = known > 0 ? known : 300;
+            continue;
+        }
+        int targets = 0;
+        for (int sq = 0; sq < 64; sq++)
+            targets += popcount((*program)(sq, 0ULL));
+        ev.value[id] = 100 + 40 * targets / 64;
+    }
+    return ev;
+}
+
+int evaluate(const Bitboards& bb, const Evaluator& ev) {
+    int score = 0;     // White's point of view
+    for (int id = 0; id < bb.numPieces; id++) {
+        if (ev.king[id] || !ev.value[id])
+            continue;
+        for (Bitboard b = bb.pieceBB[id]; b; b &= b - 1) {
+            int sq = indexLSB(b);
+            bool white = (bb.w_occupancy >> sq) & 1;
+            int rank = white ? sq / 8 : 7 - sq / 8;
+            int placement = ev.pawn[id] ? 4 * rank : centrality[sq];
+            score += white ? ev.value[id] + placement : -(ev.value[id] + placement);
+        }
+    }
+    return bb.w_to_move ? score : -score;
+}
@@ -0,0 +1,22 @@
+// eval.h
+#pragma once
+#include "rules.h"
+
+// =====================================================
+// Static evaluation
+// =====================================================
+/*
+  Material plus a small placement term, in centipawns from the side to
+  move's point of view. Standard letters get the usual values; a fairy
+  piece is valued from its average number of targets on an empty board,
+  so the same code serves any Pieces= line. Kings and neutral pieces are
+  worth 0 (a Flock king is lost by capture, which search scores as mate).
+*/
+struct Evaluator {
+    int value[MAX_PIECES] = {};         // by piece ID
+    bool pawn[MAX_PIECES] = {};
+    bool king[MAX_PIECES] = {};
+};
+
+Evaluator make_evaluator(const Bitboards& bb, const GameRules& rules);
+int evaluate(const Bitboards& bb, const Evaluator& ev);
@@ -0,0 +1,38 @@
+// history.h
+#pragma once
+#include <cstdint>
+#include <vector>
+
+// =====================================================
+// Position history
+// =====================================================
+/*
+  The Zobrist hash of every position of the game and of the current search
+  line, oldest first; back() is the position on the board. Kept next to
+  the board instead of inside it, so copying a Bitboards stays cheap.
+
+  Callers push after make_move and pop after unmake_move. Repetitions are
+  found by scanning back over at most `window` entries (the positions
+  since the last capture or pawn move) and only every `stride`-th one:
+  the hash includes side to move and sub-move index, so only positions a
+  whole number of rounds back can match.
+*/
+struct History {
+    std::vector<uint64_t> keys;
+
+    History() { keys.reserve(1024); }
+
+    void push(uint64_t key) { keys.push_back(key); }
+    void pop() { keys.pop_back(); }
+    void clear() { keys.clear(); }
+    int size() const { return static_cast<int>(keys.size()); }
+
+    // Earlier occurrences of the current position
+    int repetitions(int window, int stride) const {
+        int last = size() - 1;
+        int count = 0;
+        for (int i = last - stride; i >= 0 && last - i <= window; i -= stride)
+            count += keys[i] == keys[last];
+        return count;
+    }
+};
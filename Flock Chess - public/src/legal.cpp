@@ -0,0 +1,309 @@
+#include "legal.h"
+#include "castling.h"
+#include <atomic>
+#include <cctype>
+#include <iostream>
+
+namespace {
+
+// One side's standard pieces
+struct Side {
+    Bitboard pawns, knights, bishops, rooks, queens, king;
+};
+
+Side side_of(const Bitboards& bb, bool white) {
+    const char* letters = white ? "PNBRQK" : "pnbrqk";
+    Side s;
+    s.pawns = bb.piece_board(letters[0]);
+    s.knights = bb.piece_board(letters[1]);
+    s.bishops = bb.piece_board(letters[2]);
+    s.rooks = bb.piece_board(letters[3]);
+    s.queens = bb.piece_board(letters[4]);
+    s.king = bb.piece_board(letters[5]);
+    return s;
+}
+
+// Pieces of `attacker` (White if attackerWhite) that attack sq through occ
+Bitboard attackers(const Side& attacker, bool attackerWhite, int sq, Bitboard occ) {
+    Bitboard pawnFrom = attackerWhite ? blackPawnAttacks[sq] : whitePawnAttacks[sq];
+    return (pawnFrom & attacker.pawns)
+         | (knightAttacks[sq] & attacker.knights)
+         | (kingAttacks[sq] & attacker.king)
+         | (rook_attacks(sq, occ) & (attacker.rooks | attacker.queens))
+         | (bishop_attacks(sq, occ) & (attacker.bishops | attacker.queens));
+}
+
+struct PawnContext {
+    MoveList& list;
+    GenType type;
+    bool white;
+    Bitboard empty;
+    Bitboard them;
+    PromotionSet promos;
+};
+
+// Moves onto `targets`, each from to - offset; promotions fan out over
+// the variant's promotion pieces
+void add_pawn_targets(const PawnContext& pc, Bitboard targets, int offset, MoveType type, bool capture) {
+    const Bitboard last = pawn_promotion_rank(pc.white);
+    for (Bitboard t = targets & ~last; t; t &= t - 1) {
+        int to = indexLSB(t);
+        pc.list.push(make_move_code(to - offset, to, type, capture));
+    }
+    for (Bitboard t = targets & last; t; t &= t - 1) {
+        int to = indexLSB(t);
+        for (int i = 0; i < pc.promos.count; i++)
+            pc.list.push(make_move_code(to - offset, to, PROMOTION, capture, pc.promos.ids[i]));
+    }
+}
+
+// Pushes and captures of `pawns` that land on `mask`
+void add_pawn_moves(const PawnContext& pc, Bitboard pawns, Bitboard mask) {
+    const bool white = pc.white;
+    Bitboard pushes = pawn_pushes(pawns, pc.empty, white);
+    Bitboard doubles = pawn_double_pushes(pushes, pc.empty, white);
+
+    if (pc.type & QUIETS) {
+        add_pawn_targets(pc, pushes & mask, pawn_push_offset(white), NORMAL, false);
+        add_pawn_targets(pc, doubles & mask, 2 * pawn_push_offset(white), DOUBLE_PUSH, false);
+    }
+    if (pc.type & CAPTURES) {
+        add_pawn_targets(pc, pawn_west_attacks(pawns, white) & pc.them & mask,
+                         pawn_west_offset(white), NORMAL, true);
+        add_pawn_targets(pc, pawn_east_attacks(pawns, white) & pc.them & mask,
+                         pawn_east_offset(white), NORMAL, true);
+    }
+}
+
+void add_moves(MoveList& list, int from, Bitboard targets, Bitboard them) {
+    for (; targets; targets &= targets - 1) {
+        int to = indexLSB(targets);
+        list.push(make_move_code(from, to, NORMAL, (them >> to) & 1));
+    }
+}
+
+template <bool Legal, GenType Type>
+void generate(const Bitboards& bb, MoveList& list) {
+    list.clear();
+
+    const bool white = bb.w_to_move;
+    const Bitboard occ = bb.occupancy;
+    const Bitboard us = white ? bb.w_occupancy : bb.b_occupancy;
+    const Bitboard them = white ? bb.b_occupancy : bb.w_occupancy;
+    const Side own = side_of(bb, white);
+    const Side opp = side_of(bb, !white);
+    const int ksq = own.king ? indexLSB(own.king) : -1;
+    // Squares a move may land on for the asked kind of move
+    const Bitboard landing = ((Type & QUIETS) ? ~occ : 0ULL) | ((Type & CAPTURES) ? them : 0ULL);
+
+    Bitboard checkers = 0ULL, pinned = 0ULL, checkMask = ~0ULL;
+    if (ksq >= 0) {
+        checkers = attackers(opp, !white, ksq, occ);
+        if (Legal) {
+            Bitboard snipers = (rook_attacks(ksq, 0ULL) & (opp.rooks | opp.queens))
+                             | (bishop_attacks(ksq, 0ULL) & (opp.bishops | opp.queens));
+            for (; snipers; snipers &= snipers - 1) {
+                Bitboard blockers = betweenBB[ksq][indexLSB(snipers)] & occ;
+                if (blockers && !(blockers & (blockers - 1)) && (blockers & us))
+                    pinned |= blockers;
+            }
+            if (checkers)
+                checkMask = betweenBB[ksq][indexLSB(checkers)] | checkers;
+        }
+    }
+
+    // King steps
+    if (ksq >= 0) {
+        Bitboard steps = kingAttacks[ksq] & landing;
+        for (; steps; steps &= steps - 1) {
+            int to = indexLSB(steps);
+            if (Legal && attackers(opp, !white, to, occ ^ (1ULL << ksq)))
+                continue;
+            list.push(make_move_code(ksq, to, NORMAL, (them >> to) & 1));
+        }
+    }
+
+    // Double check: only the king may move
+    if (Legal && (checkers & (checkers - 1)))
+        return;
+
+    const Bitboard target = landing & checkMask;
+    auto restrict = [&](int from, Bitboard t) {
+        return (Legal && (pinned >> from) & 1) ? t & lineBB[ksq][from] : t;
+    };
+
+    for (Bitboard b = own.knights & ~pinned; b; b &= b - 1) {
+        int from = indexLSB(b);
+        add_moves(list, from, knightAttacks[from] & target, them);
+    }
+    for (Bitboard b = own.bishops | own.queens; b; b &= b - 1) {
+        int from = indexLSB(b);
+        add_moves(list, from, restrict(from, bishop_attacks(from, occ) & target), them);
+    }
+    for (Bitboard b = own.rooks | own.queens; b; b &= b - 1) {
+        int from = indexLSB(b);
+        add_moves(list, from, restrict(from, rook_attacks(from, occ) & target), them);
+    }
+
+    // Pawns, set-wise: unpinned ones together, then each pinned one on its line
+    PawnContext pc{ list, Type, white, ~occ, them, promotion_pieces(bb, white) };
+    add_pawn_moves(pc, own.pawns & ~pinned, checkMask);
+    for (Bitboard b = own.pawns & pinned; b; b &= b - 1)
+        add_pawn_moves(pc, b & -b, checkMask & lineBB[ksq][indexLSB(b)]);
+
+    // En passant: test the board with both pawns gone, which also
+    // catches the rank pin through the two of them. The square must be
+    // behind an enemy pawn: after a Marseillais first sub-move it is still
+    // the mover's own double push.
+    const Bitboard epSq = bb.enpassant_sq & (white ? RANK_6_BB : RANK_3_BB) & ~occ;
+    const int capSq = epSq ? indexLSB(epSq) - pawn_push_offset(white) : 0;
+    if ((Type & CAPTURES) && epSq && ((opp.pawns >> capSq) & 1)) {
+        int to = indexLSB(epSq);
+        Bitboard from = (white ? blackPawnAttacks[to] : whitePawnAttacks[to]) & own.pawns;
+        for (; from; from &= from - 1) {
+            if (Legal && ksq >= 0) {
+                Bitboard after = (occ ^ (from & -from) ^ (1ULL << capSq)) | epSq;
+                Side rest = opp;
+                rest.pawns &= ~(1ULL << capSq);
+                if (attackers(rest, !white, ksq, after))
+                    continue;
+            }
+            list.push(make_move_code(indexLSB(from), to, EN_PASSANT, true));
+        }
+    }
+
+    // Castling: never out of, through or into check
+    if ((Type & QUIETS) && ksq >= 0 && !checkers) {
+        uint8_t rights = castling_bits(bb) & (white ? W_KINGSIDE | W_QUEENSIDE : B_KINGSIDE | B_QUEENSIDE);
+        for (; rights; rights &= rights - 1) {
+            const CastlingPath& c = castlingPaths[indexLSB(rights)];
+            if (ksq != c.kingFrom || !((own.rooks >> c.rookFrom) & 1) || (occ & c.empty))
+                continue;
+            bool safe = true;
+            for (Bitboard s = c.safe; s && safe; s &= s - 1)
+                safe = !attackers(opp, !white, indexLSB(s), occ);
+            if (safe)
+                list.push(make_move_code(c.kingFrom, c.kingTo, c.type));
+        }
+    }
+}
+
+template <bool Legal>
+void generate_type(const Bitboards& bb, MoveList& list, GenType type) {
+    switch (type) {
+    case CAPTURES: generate<Legal, CAPTURES>(bb, list); break;
+    case QUIETS:   generate<Legal, QUIETS>(bb, list); break;
+    default:       generate<Legal, ALL_MOVES>(bb, list); break;
+    }
+}
+
+} // namespace
+
+void report_move_list_overflow() {
+    assert(!"move list full");
+    static std::atomic<bool> reported{ false };
+    if (!reported.exchange(true))
+        std::cerr << "warning: more than " << MAX_MOVES << " moves in a position, the rest are dropped\n";
+}
+
+PromotionSet promotion_pieces(const Bitboards& bb, bool white) {
+    PromotionSet set;
+    for (int id = 0; id < bb.numPieces; id++) {
+        unsigned char c = static_cast<unsigned char>(bb.pieceChar[id]);
+        if ((bb.neutralTypes >> id) & 1 || (white ? !std::isupper(c) : !std::islower(c)))
+            continue;
+        char upper = static_cast<char>(std::toupper(c));
+        if (upper != 'K' && upper != 'P')
+            set.ids[set.count++] = static_cast<uint8_t>(id);
+    }
+    return set;
+}
+
+void generate_legal(const Bitboards& bb, MoveList& list, GenType type) {
+    generate_type<true>(bb, list, type);
+}
+
+void generate_pseudo_legal(const Bitboards& bb, MoveList& list, GenType type) {
+    generate_type<false>(bb, list, type);
+}
+
+bool is_pawn_push(const Bitboards& bb, Move m, bool white) {
+    const int from = move_from(m), to = move_to(m);
+    const Bitboard empty = ~bb.occupancy;
+    const Bitboard push = pawn_pushes(1ULL << from, empty, white);
+    const Bitboard last = pawn_promotion_rank(white);
+    const Bitboard toBit = 1ULL << to;
+
+    switch (move_type(m)) {
+    case NORMAL:
+        return m == make_move_code(from, to) && (push & ~last & toBit);
+    case DOUBLE_PUSH:
+        return m == make_move_code(from, to, DOUBLE_PUSH) && (pawn_double_pushes(push, empty, white) & toBit);
+    case PROMOTION: {
+        if (!(push & last & toBit))
+            return false;
+        PromotionSet promos = promotion_pieces(bb, white);
+        for (int i = 0; i < promos.count; i++)
+            if (m == make_move_code(from, to, PROMOTION, false, promos.ids[i]))
+                return true;
+        return false;
+    }
+    default:
+        return false;
+    }
+}
+
+bool is_legal_quiet(const Bitboards& bb, Move m) {
+    const bool white = bb.w_to_move;
+    const int from = move_from(m), to = move_to(m);
+    const Bitboard fromBit = 1ULL << from, toBit = 1ULL << to;
+    const Bitboard occ = bb.occupancy;
+    if (!((white ? bb.w_occupancy : bb.b_occupancy) & fromBit) || (occ & toBit))
+        return false;
+
+    const Side own = side_of(bb, white);
+    const Side opp = side_of(bb, !white);
+    const int ksq = own.king ? indexLSB(own.king) : -1;
+    const MoveType type = move_type(m);
+
+    if (type == CASTLE_KING || type == CASTLE_QUEEN) {
+        const CastlingPath& c = castling_path(type, from);
+        if (m != make_move_code(c.kingFrom, c.kingTo, c.type) || ksq != c.kingFrom
+            || !(castling_bits(bb) & c.right) || !((own.rooks >> c.rookFrom) & 1) || (occ & c.empty))
+            return false;
+        for (Bitboard s = c.safe | fromBit; s; s &= s - 1)
+            if (attackers(opp, !white, indexLSB(s), occ))
+                return false;
+        return true;
+    }
+
+    if (own.pawns & fromBit) {
+        if (!is_pawn_push(bb, m, white))
+            return false;
+    } else {
+        Bitboard reach = 0ULL;
+        if (own.knights & fromBit) reach |= knightAttacks[from];
+        if (own.king & fromBit) reach |= kingAttacks[from];
+        if ((own.bishops | own.queens) & fromBit) reach |= bishop_attacks(from, occ);
+        if ((own.rooks | own.queens) & fromBit) reach |= rook_attacks(from, occ);
+        if (m != make_move_code(from, to) || !(reach & toBit))
+            return false;
+    }
+
+    // Nothing is captured, so the king is safe unless the new occupancy
+    // opens (or leaves) a line to it
+    if (ksq < 0)
+        return true;
+    return !attackers(opp, !white, from == ksq ? to : ksq, occ ^ fromBit ^ toBit);
+}
+
+bool king_in_check(const Bitboards& bb, bool white) {
+    Side own = side_of(bb, white);
+    if (!own.king)
+        return false;
+    return attackers(side_of(bb, !white), !white, indexLSB(own.king), bb.occupancy) != 0;
+}
+
+Bitboard attackers_to(const Bitboards& bb, int sq, Bitboard occ) {
+    return attackers(side_of(bb, true), true, sq, occ) | attackers(side_of(bb, false), false, sq, occ);
+}
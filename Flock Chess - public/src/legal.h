@@ -0,0 +1,79 @@
+// legal.h
+#pragma once
+#include <cassert>
+#include "makemove.h"
+#include "bitboards/lines.h"
+
+// =====================================================
+// Legal move generation (standard rules)
+// =====================================================
+/*
+  For the variants that use the standard piece set (Marseillais, 3D, QE,
+  Power): the letters K Q R B N P, upper case for White and lower case for
+  Black. Neutral pieces only block. Each Marseillais sub-move is generated
+  as an ordinary move.
+
+  generate_legal() filters with the checkers of the side to move, a check
+  mask (block or capture a lone checker, from betweenBB) and pin masks
+  (pinned pieces stay on lineBB through their king); only king steps and
+  en passant test the resulting board. Pawns move set-wise: all unpinned
+  pawns of a side in a few shifts (bitboards/pawn.h), promotions fanning
+  out over promotion_pieces(). generate_pseudo_legal() emits the
+  same moves before king safety, except that castling is always checked.
+*/
+// 218 is the most any standard chess position has. Fairy sets (Flock's
+// amazon, wide promotion choices) and Marseillais sub-moves can go past
+// 256, so a full list drops further moves, in release builds too, and
+// reports it once (asserts in debug builds).
+constexpr int MAX_MOVES = 256;
+
+void report_move_list_overflow();
+
+struct MoveList {
+    Move moves[MAX_MOVES];
+    int size = 0;
+
+    void push(Move m) {
+        if (size < MAX_MOVES)
+            moves[size++] = m;
+        else
+            report_move_list_overflow();
+    }
+    void clear() { size = 0; }
+    const Move* begin() const { return moves; }
+    const Move* end() const { return moves + size; }
+};
+
+// Piece IDs a pawn of the given side promotes to: that side's types other
+// than K and P, in the variant's piece order (Q R B N for the standard set)
+struct PromotionSet {
+    uint8_t ids[MAX_PIECES];
+    int count = 0;
+};
+
+PromotionSet promotion_pieces(const Bitboards& bb, bool white);
+
+// `type` picks captures (en passant included), quiet moves (pushes,
+// push promotions and castling included) or both
+void generate_legal(const Bitboards& bb, MoveList& list, GenType type = ALL_MOVES);
+void generate_pseudo_legal(const Bitboards& bb, MoveList& list, GenType type = ALL_MOVES);
+
+// True when m is a pawn push as the generators encode it: to the empty
+// square ahead, a double push from the start rank, or a promotion to one
+// of that side's promotion_pieces() on the last rank. `white` is the side
+// whose pawn moves, which need not be the side to move; whether a pawn
+// stands on the from square is the caller's check.
+bool is_pawn_push(const Bitboards& bb, Move m, bool white);
+
+// True when generate_legal(bb, list, QUIETS) would produce m, checked
+// without generating the list (a TT move from another position)
+bool is_legal_quiet(const Bitboards& bb, Move m);
+
+// True when the king of the given side stands attacked
+bool king_in_check(const Bitboards& bb, bool white);
+
+// Pieces of both sides that attack sq through occ, by reverse lookup: the
+// rook, bishop, knight and king tables from sq, and the other colour's
+// pawn table. Pieces missing from occ are still reported; callers that
+// take pieces off (SEE) mask with occ.
+Bitboard attackers_to(const Bitboards& bb, int sq, Bitboard occ);
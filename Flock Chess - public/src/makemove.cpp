@@ -0,0 +1,182 @@
+#include "makemove.h"
+#include "castling.h"
+
+uint8_t castling_bits(const Bitboards& bb) {
+    return (bb.w_k_castle ? W_KINGSIDE : 0) | (bb.w_q_castle ? W_QUEENSIDE : 0)
+         | (bb.b_k_castle ? B_KINGSIDE : 0) | (bb.b_q_castle ? B_QUEENSIDE : 0);
+}
+
+void set_castling_bits(Bitboards& bb, uint8_t bits) {
+    bb.w_k_castle = bits & W_KINGSIDE;
+    bb.w_q_castle = bits & W_QUEENSIDE;
+    bb.b_k_castle = bits & B_KINGSIDE;
+    bb.b_q_castle = bits & B_QUEENSIDE;
+}
+
+static Bitboard& side_board(Bitboards& bb, int color) {
+    return color == WHITE ? bb.w_occupancy : color == BLACK ? bb.b_occupancy : bb.n_occupancy;
+}
+
+static int color_on(const Bitboards& bb, int sq) {
+    Bitboard bit = 1ULL << sq;
+    return (bb.w_occupancy & bit) ? WHITE : (bb.b_occupancy & bit) ? BLACK : NEUTRAL;
+}
+
+static bool is_pawn(const Bitboards& bb, int id) {
+    return bb.pieceChar[id] == 'P' || bb.pieceChar[id] == 'p';
+}
+
+// Board-only primitives; the hash is handled by the callers
+static void put(Bitboards& bb, int id, int color, int sq) {
+    Bitboard bit = 1ULL << sq;
+    bb.pieceBB[id] |= bit;
+    bb.occupancy |= bit;
+    side_board(bb, color) |= bit;
+    bb.mailbox[sq] = (uint8_t)id;
+}
+
+static void remove(Bitboards& bb, int id, int color, int sq) {
+    Bitboard bit = 1ULL << sq;
+    bb.pieceBB[id] &= ~bit;
+    bb.occupancy &= ~bit;
+    side_board(bb, color) &= ~bit;
+    bb.mailbox[sq] = NO_PIECE;
+}
+
+static void shift(Bitboards& bb, int id, int color, int from, int to) {
+    Bitboard fromTo = (1ULL << from) | (1ULL << to);
+    bb.pieceBB[id] ^= fromTo;
+    bb.occupancy ^= fromTo;
+    side_board(bb, color) ^= fromTo;
+    bb.mailbox[from] = NO_PIECE;
+    bb.mailbox[to] = (uint8_t)id;
+}
+
+static uint64_t key(const Bitboards& bb, const Zobrist& z, int id, int sq) {
+    return z.piece_square[z.letter_idx[static_cast<unsigned char>(bb.pieceChar[id])]][sq];
+}
+
+void make_move(Bitboards& bb, Move m, UndoInfo& undo, const Zobrist& z) {
+    const int from = move_from(m), to = move_to(m);
+    const MoveType type = move_type(m);
+    const int id = bb.mailbox[from];
+    const int color = color_on(bb, from);
+
+    undo.hash = bb.zobrist_hash;
+    undo.enpassant_sq = bb.enpassant_sq;
+    undo.halfmove_clock = bb.halfmove_clock;
+    undo.fullmove_number = bb.fullmove_number;
+    undo.castling = castling_bits(bb);
+    undo.sub_move = (uint8_t)bb.sub_move;
+    undo.w_to_move = bb.w_to_move;
+    undo.moved = (uint8_t)id;
+    undo.captured = NO_PIECE;
+    undo.capturedColor = NEUTRAL;
+
+    // A neutral piece moving on its own (Flock's duck sub-move) leaves the
+    // en passant square and the clock to the piece move before it
+    uint64_t hash = bb.zobrist_hash;
+    if (color != NEUTRAL) {
+        if (bb.enpassant_sq)
+            hash ^= z.enpassant_file[indexLSB(bb.enpassant_sq) & 7];
+        bb.enpassant_sq = 0ULL;
+        bb.halfmove_clock++;
+    }
+
+    // Capture, including the pawn taken en passant
+    int capSq = type == EN_PASSANT ? (color == WHITE ? to - 8 : to + 8) : to;
+    if (bb.mailbox[capSq] != NO_PIECE) {
+        undo.captured = bb.mailbox[capSq];
+        undo.capturedColor = (uint8_t)color_on(bb, capSq);
+        hash ^= key(bb, z, undo.captured, capSq);
+        remove(bb, undo.captured, undo.capturedColor, capSq);
+        bb.halfmove_clock = 0;
+    }
+
+    hash ^= key(bb, z, id, from);
+    shift(bb, id, color, from, to);
+
+    if (type == PROMOTION) {
+        int promo = move_promo(m);
+        remove(bb, id, color, to);
+        put(bb, promo, color, to);
+        hash ^= key(bb, z, promo, to);
+    } else {
+        hash ^= key(bb, z, id, to);
+    }
+
+    if (type == CASTLE_KING || type == CASTLE_QUEEN) {
+        const CastlingPath& c = castling_path(type, from);
+        int rook = bb.mailbox[c.rookFrom];
+        hash ^= key(bb, z, rook, c.rookFrom) ^ key(bb, z, rook, c.rookTo);
+        shift(bb, rook, color, c.rookFrom, c.rookTo);
+    }
+
+    if (is_pawn(bb, id)) {
+        bb.halfmove_clock = 0;
+        if (type == DOUBLE_PUSH) {
+            bb.enpassant_sq = 1ULL << ((from + to) / 2);
+            hash ^= z.enpassant_file[from & 7];
+        }
+    }
+
+    if (move_has_duck(m)) {
+        int duckFrom = move_duck_from(m), duckTo = move_duck_to(m);
+        int duck = bb.mailbox[duckFrom];
+        hash ^= key(bb, z, duck, duckFrom) ^ key(bb, z, duck, duckTo);
+        shift(bb, duck, NEUTRAL, duckFrom, duckTo);
+    }
+
+    uint8_t rights = undo.castling & castlingMasks[from] & castlingMasks[to];
+    for (uint8_t changed = undo.castling ^ rights; changed; changed &= changed - 1)
+        hash ^= z.castling_rights[indexLSB(changed)];
+    set_castling_bits(bb, rights);
+
+    hash ^= z.sub_move[bb.sub_move % ZOBRIST_SUB_MOVES];
+    if (++bb.sub_move >= bb.moves_per_turn) {
+        bb.sub_move = 0;
+        if (!bb.w_to_move)
+            bb.fullmove_number++;
+        bb.w_to_move = !bb.w_to_move;
+        hash ^= z.side_to_move;
+    }
+    hash ^= z.sub_move[bb.sub_move % ZOBRIST_SUB_MOVES];
+
+    bb.zobrist_hash = hash;
+}
+
+void unmake_move(Bitboards& bb, Move m, const UndoInfo& undo) {
+    const int from = move_from(m), to = move_to(m);
+    const MoveType type = move_type(m);
+    const int color = color_on(bb, to);
+
+    if (move_has_duck(m)) {
+        int duckFrom = move_duck_from(m), duckTo = move_duck_to(m);
+        shift(bb, bb.mailbox[duckTo], NEUTRAL, duckTo, duckFrom);
+    }
+
+    if (type == CASTLE_KING || type == CASTLE_QUEEN) {
+        const CastlingPath& c = castling_path(type, from);
+        shift(bb, bb.mailbox[c.rookTo], color, c.rookTo, c.rookFrom);
+    }
+
+    if (type == PROMOTION) {
+        remove(bb, bb.mailbox[to], color, to);
+        put(bb, undo.moved, color, from);
+    } else {
+        shift(bb, undo.moved, color, to, from);
+    }
+
+    if (undo.captured != NO_PIECE) {
+        int capSq = type == EN_PASSANT ? (color == WHITE ? to - 8 : to + 8) : to;
+        put(bb, undo.captured, undo.capturedColor, capSq);
+    }
+
+    bb.zobrist_hash = undo.hash;
+    bb.enpassant_sq = undo.enpassant_sq;
+    bb.halfmove_clock = undo.halfmove_clock;
+    bb.fullmove_number = undo.fullmove_number;
+    bb.sub_move = undo.sub_move;
+    bb.w_to_move = undo.w_to_move;
+    set_castling_bits(bb, undo.castling);
+}
@@ -0,0 +1,39 @@
+// makemove.h
+#pragma once
+#include "movegen.h"
+#include "move.h"
+
+// =====================================================
+// make_move / unmake_move
+// =====================================================
+/*
+  Both update the board in place: piece boards, mailbox, the three
+  occupancy sets, castling rights, en passant square, clocks, side to move
+  and the Zobrist hash are patched for just the squares the move touches;
+  nothing is recomputed from scratch. unmake_move restores from the
+  UndoInfo filled by make_move, so moves must be undone in reverse order.
+
+  The move must be pseudo-legal for the board: no legality check is made.
+  Side to move flips once every bb.moves_per_turn sub-moves (Move_num).
+  A move of a neutral piece by itself keeps the en passant square and the
+  halfmove clock.
+*/
+struct UndoInfo {
+    uint64_t hash;
+    Bitboard enpassant_sq;
+    int halfmove_clock;
+    int fullmove_number;
+    uint8_t moved;              // piece ID that moved (the pawn, for a promotion)
+    uint8_t captured;           // piece ID taken, NO_PIECE if none
+    uint8_t capturedColor;      // PieceColor of the taken piece
+    uint8_t castling;           // CastlingRight bits before the move
+    uint8_t sub_move;
+    bool w_to_move;
+};
+
+void make_move(Bitboards& bb, Move m, UndoInfo& undo, const Zobrist& z);
+void unmake_move(Bitboards& bb, Move m, const UndoInfo& undo);
+
+// Castling rights as CastlingRight bits, and back
+uint8_t castling_bits(const Bitboards& bb);
+void set_castling_bits(Bitboards& bb, uint8_t bits);
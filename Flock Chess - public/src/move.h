@@ -0,0 +1,53 @@
+// move.h
+#pragma once
+#include <cstdint>
+
+// =====================================================
+// Move encoding
+// =====================================================
+/*
+  One move in 32 bits:
+     0- 5  from square
+     6-11  to square
+    12-14  kind (MoveType below)
+    15     capture flag
+    16-19  promotion piece ID (Bitboards::pieceChar index), PROMOTION only
+    20-25  duck from  \  neutral piece relocated after the move (Flock);
+    26-31  duck to    /  equal squares mean no relocation
+  Castling is encoded as the king's move; the rook's squares follow from
+  the king's. Multi-move turns (Move_num) need no bits: the board counts
+  sub-moves and hands the turn over after the last one.
+  Move 0 (a1 to a1) is never legal and serves as "no move".
+*/
+using Move = uint32_t;
+
+enum MoveType : uint8_t {
+    NORMAL = 0,
+    DOUBLE_PUSH = 1,
+    EN_PASSANT = 2,
+    CASTLE_KING = 3,
+    CASTLE_QUEEN = 4,
+    PROMOTION = 5,
+};
+
+constexpr Move NO_MOVE = 0;
+
+constexpr Move make_move_code(int from, int to, MoveType type = NORMAL, bool capture = false,
+                              int promo = 0, int duckFrom = 0, int duckTo = 0) {
+    return Move(from) | Move(to) << 6 | Move(type) << 12 | Move(capture) << 15
+         | Move(promo) << 16 | Move(duckFrom) << 20 | Move(duckTo) << 26;
+}
+
+constexpr int move_from(Move m)         { return int(m & 63); }
+constexpr int move_to(Move m)           { return int((m >> 6) & 63); }
+constexpr MoveType move_type(Move m)    { return MoveType((m >> 12) & 7); }
+constexpr bool move_is_capture(Move m)  { return (m >> 15) & 1; }
+constexpr int move_promo(Move m)        { return int((m >> 16) & 15); }
+constexpr int move_duck_from(Move m)    { return int((m >> 20) & 63); }
+constexpr int move_duck_to(Move m)      { return int((m >> 26) & 63); }
+constexpr bool move_has_duck(Move m)    { return move_duck_from(m) != move_duck_to(m); }
+
+// Adds (or replaces) the neutral-piece relocation of a move
+constexpr Move with_duck(Move m, int duckFrom, int duckTo) {
+    return (m & 0x000FFFFFu) | Move(duckFrom) << 20 | Move(duckTo) << 26;
+}
@@ -1,147 +1,97 @@
 #include "movegen.h"
+#include "castling.h"
+#include <algorithm>
 
-using AttackFunc = Bitboard(*)(int sq, Bitboard occ);
-
-std::unordered_map<int, AttackFunc> attack_map = {
-    {1,  rook_attacks},
-    {2,  bishop_attacks},
-    {3,  knight_attacks},
-    {16, king_attacks},
-    {17, white_pawn_attacks},
-    {19, duck_attacks},
-    {20, black_pawn_attacks},
-};
-
-Bitboard run_attack(int code, int sq, Bitboard occ) {
-    auto it = attack_map.find(code);
-    if (it == attack_map.end())
-        throw std::runtime_error("Unknown attack code: " + std::to_string(code));
-    return it->second(sq, occ);
-}
-
-Bitboard evaluate_expr(const std::string& s, int sq, Bitboard occ)
+void movegen(const Bitboards& bb, const PiecePrograms& programs, MoveTargets& out, GenType type)
 {
-    if (s.find('+') == std::string::npos) {
-        // simple number
-        return run_attack(std::stoi(s), sq, occ);
-    }
-
-    // a + b + c form
-    std::stringstream ss(s);
-    std::string token;
-    Bitboard result = 0;
-    while (std::getline(ss, token, '+')) {
-        result ^= run_attack(std::stoi(token), sq, occ);
-    }
-    return result;
-}
-
-std::array<Bitboard, 64> piece_movegen(const Bitboards& bb, std::unordered_map<char, std::string> piece_to_expr, Bitboard occ)
-{
-    std::array<Bitboard, 64> moves{};
-
+    out.quiet.fill(0ULL);
+    out.captures.fill(0ULL);
+
+    const Bitboard occ = bb.occupancy;
+    const Bitboard empty = (type & QUIETS) ? ~occ : 0ULL;
+    // Enemy board per side: white pieces take black ones and vice versa
+    const Bitboard enemyOfWhite = (type & CAPTURES) ? bb.b_occupancy : 0ULL;
+    const Bitboard enemyOfBlack = (type & CAPTURES) ? bb.w_occupancy : 0ULL;
+
+    Bitboard pawns[2] = { 0ULL, 0ULL };    // white-moving, black-moving
+    // En passant square each pawn direction may take on (rank 6 / rank 3),
+    // unless a duck has landed on it
+    const Bitboard epSq = bb.enpassant_sq & ~occ;
+    const Bitboard epTarget[2] = { epSq & RANK_6_BB, epSq & RANK_3_BB };
     Bitboard remaining = occ;
-
     while (remaining) {
         int sq = indexLSB(remaining);
         remaining &= remaining - 1;
 
-        Bitboard bit = 1ULL << sq;
-
-        // find which piece is on this square
-        char found = 0;
-        for (auto& [piece, board] : bb.pieceBoards) {
-            if (board & bit) {
-                found = piece;
-                break;
-            }
-        }
-        if (!found) continue;   // impossible but safe
-
-        // get attack expression, e.g. "1+2", "3", "17"
-        auto it = piece_to_expr.find(found);
-        if (it == piece_to_expr.end())
+        // compiled attack program, e.g. "1+2", "3", "17"
+        const AttackProgram& program = programs[static_cast<unsigned char>(bb.piece_on(sq))];
+        if (program.count == 0)
             continue;
 
-        const std::string& expr = it->second;
-
-        Bitboard result = evaluate_expr(expr, sq, occ);
-
-        moves[sq] = result;
-    }
-
-    // remove white pieces from moves
-    for (int sq = 0; sq < 64; ++sq) {
-        moves[sq] &= ~occ;
-    }
-
-    return moves;
-}
-std::array<Bitboard, 64> neutral_piece_movegen(const Bitboards& bb, std::unordered_map<char, std::string> piece_to_expr, Bitboard neutral_occ ,Bitboard occ)
-{
-    std::array<Bitboard, 64> moves{};
-
-    Bitboard remaining = neutral_occ;
-
-    while (remaining) {
-        int sq = indexLSB(remaining);
-        remaining &= remaining - 1;
-
         Bitboard bit = 1ULL << sq;
-
-        // find which piece is on this square
-        char found = 0;
-        for (auto& [piece, board] : bb.pieceBoards) {
-            if (board & bit) {
-                found = piece;
-                break;
-            }
-        }
-        if (!found) continue;   // impossible but safe
-
-        // get attack expression, e.g. "1+2", "3", "17"
-        auto it = piece_to_expr.find(found);
-        if (it == piece_to_expr.end())
+        Bitboard enemy = (bb.w_occupancy & bit) ? enemyOfWhite
+                       : (bb.b_occupancy & bit) ? enemyOfBlack : 0ULL;
+
+        Bitboard targets = program(sq, occ);
+        if (program.pawn) {
+            // Diagonals only capture (en passant included); pushes come below
+            int side = program.pawn == PAWN_BLACK;
+            pawns[side] |= bit;
+            out.captures[sq] = targets & (enemy | (enemy ? epTarget[side] : 0ULL));
             continue;
-
-        const std::string& expr = it->second;
-
-        Bitboard result = evaluate_expr(expr, sq, occ);
-
-        moves[sq] = result;
+        }
+        out.quiet[sq] = targets & empty;
+        out.captures[sq] = targets & enemy;
     }
 
-    // remove white pieces from moves
-    for (int sq = 0; sq < 64; ++sq) {
-        moves[sq] &= ~occ;
+    // Pawn pushes for every pawn of a side at once, blocked by any piece
+    for (int side = 0; side < 2 && (type & QUIETS); side++) {
+        bool white = side == 0;
+        int offset = pawn_push_offset(white);
+        Bitboard pushes = pawn_pushes(pawns[side], empty, white);
+        for (Bitboard t = pushes; t; t &= t - 1) {
+            int to = indexLSB(t);
+            out.quiet[to - offset] |= 1ULL << to;
+        }
+        for (Bitboard t = pawn_double_pushes(pushes, empty, white); t; t &= t - 1) {
+            int to = indexLSB(t);
+            out.quiet[to - 2 * offset] |= 1ULL << to;
+        }
     }
 
-    return moves;
+    // Castling as a king target: right held, king and rook home, path empty
+    // (a duck blocks). Attacked squares are generate_legal()'s business;
+    // Flock has no check.
+    if (type & QUIETS) {
+        const bool rights[4] = { bb.w_k_castle, bb.w_q_castle, bb.b_k_castle, bb.b_q_castle };
+        for (int i = 0; i < 4; i++) {
+            const CastlingPath& c = castlingPaths[i];
+            bool white = i < 2;
+            if (rights[i] && !(occ & c.empty)
+                && bb.piece_on(c.kingFrom) == (white ? 'K' : 'k')
+                && bb.piece_on(c.rookFrom) == (white ? 'R' : 'r'))
+                out.quiet[c.kingFrom] |= 1ULL << c.kingTo;
+        }
+    }
 }
-std::array<Bitboard, 64> movegen(const Bitboards& bb, const std::unordered_map<char, std::string>& piece_to_expr) 
+
+void movegen(const Bitboards& bb, const PiecePrograms& programs, MoveBoards& out)
 {
-    std::array<Bitboard, 64> moves = piece_movegen(bb, piece_to_expr, bb.w_occupancy);
-
-    auto black_moves = piece_movegen(bb, piece_to_expr, bb.b_occupancy);
-    auto neutral_moves = neutral_piece_movegen(
-        bb,
-        piece_to_expr,
-        bb.occupancy & ~(bb.w_occupancy | bb.b_occupancy),
-        bb.occupancy
-    );
-
-    for (int i = 0; i < 64; i += 4) {
-        moves[i+0] |= black_moves[i+0] | neutral_moves[i+0];
-        moves[i+1] |= black_moves[i+1] | neutral_moves[i+1];
-        moves[i+2] |= black_moves[i+2] | neutral_moves[i+2];
-        moves[i+3] |= black_moves[i+3] | neutral_moves[i+3];
-    }
+    MoveTargets targets;
+    movegen(bb, programs, targets);
+    for (int sq = 0; sq < 64; ++sq)
+        out[sq] = targets.quiet[sq] | targets.captures[sq];
+}
 
+MoveBoards movegen(const Bitboards& bb, const PiecePrograms& programs)
+{
+    MoveBoards moves;
+    movegen(bb, programs, moves);
     return moves;
 }
 
 
-std::array<Bitboard, 64> test_movegen(const Bitboards& bb, std::unordered_map<char, std::string> piece_to_expr)
+std::array<Bitboard, 64> test_movegen(const Bitboards& bb, const PiecePrograms& programs)
 {
     std::array<Bitboard, 64> moves{};
     Bitboard occ = bb.occupancy;
@@ -152,26 +102,16 @@ std::array<Bitboard, 64> test_movegen(const Bitboards& bb, std::unordered_map<ch
         int sq = indexLSB(remaining);
         remaining &= remaining - 1;
 
-        Bitboard bit = 1ULL << sq;
-
-        // find which piece is on this square
-        char found = 0;
-        for (auto& [piece, board] : bb.pieceBoards) {
-            if (board & bit) {
-                found = piece;
-                break;
-            }
-        }
+        // which piece is on this square
+        char found = bb.piece_on(sq);
         if (!found) continue;   // impossible but safe
 
-        // get attack expression, e.g. "1+2", "3", "17"
-        auto it = piece_to_expr.find(found);
-        if (it == piece_to_expr.end())
+        // compiled attack program, e.g. "1+2", "3", "17"
+        const AttackProgram& program = programs[static_cast<unsigned char>(found)];
+        if (program.count == 0)
             continue;
 
-        const std::string& expr = it->second;
-
-        Bitboard result = evaluate_expr(expr, sq, occ);
+        Bitboard result = program(sq, occ);
 
         moves[sq] = result;
     }
@@ -183,9 +123,7 @@ std::array<Bitboard, 64> test_movegen(const Bitboards& bb, std::unordered_map<ch
 // Your init_moves() function
 // ------------------------------------------------------------
 uint64_t init_moves() {
-    // init_bishop_magics();
-    // init_rook_magics();
-    // init_duck_magics();
+    init_attack_tables();
 
     uint64_t a = bishop_attacks(0, 0ULL);
     uint64_t b = rook_attacks(0, 0ULL);
@@ -203,32 +141,25 @@ uint64_t init_moves() {
     return a;
 }
 
-uint64_t rand64(std::mt19937_64 &rng) {
-    std::uniform_int_distribution<uint64_t> dist(0, UINT64_MAX);
-    return dist(rng);
-}
-
 void init_zobrist(Zobrist &z,
                   const std::vector<char>& piece_list,
                   size_t num_quantum_layers)
 {
     // Copy the piece list to the struct
     z.piece_idx.clear();
+    z.letter_idx.fill(-1);
     for (size_t i = 0; i < piece_list.size(); ++i) {
         z.piece_idx[piece_list[i]] = static_cast<int>(i);
+        z.letter_idx[static_cast<unsigned char>(piece_list[i]) & 127] = static_cast<int>(i);
     }
 
-    // Seed the RNG with high-resolution clock
-    std::mt19937_64 rng(
-        std::chrono::high_resolution_clock::now().time_since_epoch().count()
-    );
-
     z.piece_square.clear();
     z.piece_square.resize(piece_list.size());
 
     for (size_t i = 0; i < piece_list.size(); ++i) {
+        uint64_t letter = static_cast<unsigned char>(piece_list[i]) & 127;
         for (int sq = 0; sq < 64; ++sq) {
-            z.piece_square[i][sq] = rand64(rng);
+            z.piece_square[i][sq] = zobrist_key(ZS_PIECE + letter, sq);
         }
     }
     z.quantum_square.clear();
@@ -236,25 +167,31 @@ void init_zobrist(Zobrist &z,
 
     for (size_t layer = 0; layer < num_quantum_layers; ++layer) {
         for (int sq = 0; sq < 64; ++sq) {
-            z.quantum_square[layer][sq] = rand64(rng);
+            z.quantum_square[layer][sq] = zobrist_key(ZS_QUANTUM + layer, sq);
         }
     }
 
     for (int i = 0; i < 4; ++i)
-        z.castling_rights[i] = rand64(rng);
+        z.castling_rights[i] = zobrist_key(ZS_CASTLING, i);
     for (int f = 0; f < 8; ++f)
-        z.enpassant_file[f] = rand64(rng);
+        z.enpassant_file[f] = zobrist_key(ZS_ENPASSANT, f);
+
+    z.side_to_move = zobrist_key(ZS_SIDE, 0);
 
-    z.side_to_move = rand64(rng);  // IMPORTANT: this must be a 64-bit number
+    // A turn's first sub-move adds nothing, so Move_num = 1 variants hash
+    // as before the index existed
+    z.sub_move[0] = 0ULL;
+    for (int i = 1; i < ZOBRIST_SUB_MOVES; ++i)
+        z.sub_move[i] = zobrist_key(ZS_SUB_MOVE, i);
 }
 
 
 uint64_t compute_zobrist(const Bitboards& bb, const Zobrist& table) {
     uint64_t hash = 0ULL;
 
-    for (const auto& [piece, board] : bb.pieceBoards) {
-        int idx = table.piece_idx.at(piece);
-        Bitboard b = board;
+    for (int id = 0; id < bb.numPieces; ++id) {
+        int idx = table.piece_idx.at(bb.pieceChar[id]);
+        Bitboard b = bb.pieceBB[id];
         while (b) {
             int sq = indexLSB(b);
             b &= b-1;
@@ -280,8 +217,9 @@ uint64_t compute_zobrist(const Bitboards& bb, const Zobrist& table) {
     }
 
 
-    // side to move
+    // side to move, and how far into its turn
     if (!bb.w_to_move) hash ^= table.side_to_move;
+    hash ^= table.sub_move[bb.sub_move % ZOBRIST_SUB_MOVES];
 
     // castling rights
     if (bb.w_k_castle) hash ^= table.castling_rights[0];
@@ -309,9 +247,47 @@ inline int sq_index(int rank, int file) {
 // Parse FEN into bitboards
 // ------------------------------------------------------------
 
+// Side to move, castling, en passant and clocks: the FEN fields after the
+// board. Missing or malformed fields keep the Bitboards defaults.
+static void parse_fen_state(Bitboards& bb, const std::string& fen)
+{
+    std::istringstream ss(fen);
+    std::string board, side, castling, ep, halfmove, fullmove;
+    ss >> board >> side >> castling >> ep >> halfmove >> fullmove;
+
+    if (side == "b")
+        bb.w_to_move = false;
+
+    if (!castling.empty()) {
+        bb.w_k_castle = castling.find('K') != std::string::npos;
+        bb.w_q_castle = castling.find('Q') != std::string::npos;
+        bb.b_k_castle = castling.find('k') != std::string::npos;
+        bb.b_q_castle = castling.find('q') != std::string::npos;
+    }
+
+    if (ep.size() == 2 && ep[0] >= 'a' && ep[0] <= 'h' && ep[1] >= '1' && ep[1] <= '8')
+        bb.enpassant_sq = 1ULL << sq_index(ep[1] - '1', ep[0] - 'a');
+
+    if (!halfmove.empty() && isdigit(static_cast<unsigned char>(halfmove[0])))
+        bb.halfmove_clock = std::stoi(halfmove);
+    if (!fullmove.empty() && isdigit(static_cast<unsigned char>(fullmove[0])))
+        bb.fullmove_number = std::max(1, std::stoi(fullmove));
+}
+
 Bitboards parse_fen_bitboards(const std::string& fen)
+{
+    return parse_fen_bitboards(fen, {}, {});
+}
+
+Bitboards parse_fen_bitboards(const std::string& fen, const std::vector<char>& pieces,
+                              const std::vector<char>& neutrals)
 {
     Bitboards bb;
+    for (char c : pieces) {
+        int id = bb.add_piece_type(c);
+        if (std::find(neutrals.begin(), neutrals.end(), c) != neutrals.end())
+            bb.neutralTypes |= 1u << id;
+    }
 
     int rank = 7;
     int file = 0;
@@ -339,23 +315,25 @@ Bitboards parse_fen_bitboards(const std::string& fen)
         int sq = sq_index(rank, file);
         uint64_t bit = 1ULL << sq;
 
-        // Ensure entry exists for this piece type
-        bb.pieceBoards[c] |= bit;
+        // Registers the piece type on first sight
+        bb.put_piece(c, sq);
 
-        // Add globally to occupancy
+        // Add globally to occupancy, then to the owner's
         bb.occupancy |= bit;
-        if (!neutral) {
-            // Neutral pieces go to both sides' occupancy
+        if (neutral || std::find(neutrals.begin(), neutrals.end(), c) != neutrals.end()) {
+            bb.n_occupancy |= bit;
+            bb.neutralTypes |= 1u << bb.mailbox[sq];
+        }
+        else if (isupper(static_cast<unsigned char>(c)))
             bb.w_occupancy |= bit;
+        else
             bb.b_occupancy |= bit;
-        }
-        else {
-            neutral = false;
-        }
+        neutral = false;
 
         file++;
     }
 
+    parse_fen_state(bb, fen);
     return bb;
 }
 
@@ -8,6 +8,7 @@
 #include "bitboards/king.h"
 #include "bitboards/pawn.h"
 #include "bitboards/magic.h"
+#include "bitboards/attacks.h"
 #include "bitutils.h"
 
 #include <unordered_map>
@@ -20,6 +21,40 @@
 #include <functional>
 #include <random>
 #include <chrono>
+#include <stdexcept>
+
+// ================== Zobrist keys ==================
+/*
+  Every key is a fixed function of what it stands for: a piece key depends
+  on the piece letter and square, not on the variant's piece order, so the
+  same position hashes the same in every process, run and variant sharing
+  its letters. zobrist_key() is constexpr; init_zobrist() only lays the
+  keys out for a piece list.
+*/
+constexpr uint64_t ZOBRIST_SEED = 0x464C4F434B5A4F42ULL;      // "FLOCKZOB"
+constexpr int ZOBRIST_SUB_MOVES = 8;   // within-turn index keys; Move_num above wraps
+
+constexpr uint64_t splitmix64(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+// Key `index` of key family `stream`
+constexpr uint64_t zobrist_key(uint64_t stream, uint64_t index) {
+    return splitmix64(splitmix64(ZOBRIST_SEED ^ stream) ^ index);
+}
+
+// Key families
+enum ZobristStream : uint64_t {
+    ZS_PIECE = 0,           // + letter (0..127), index square
+    ZS_QUANTUM = 128,       // + layer, index square
+    ZS_CASTLING = 1 << 20,
+    ZS_ENPASSANT,
+    ZS_SIDE,
+    ZS_SUB_MOVE
+};
 
 struct Zobrist {
     std::vector<std::array<uint64_t,64>> piece_square;
@@ -27,15 +62,39 @@ struct Zobrist {
     std::array<uint64_t, 4> castling_rights;   // K Q k q
     std::array<uint64_t,8> enpassant_file;     // a–h
     uint64_t side_to_move;
+    std::array<uint64_t, ZOBRIST_SUB_MOVES> sub_move;   // sub-moves played this turn; [0] is 0
 
     std::unordered_map<char,int> piece_idx;
+    std::array<int, 128> letter_idx;           // piece_idx as a flat table, -1 if absent
+};
+
+enum PieceColor : uint8_t { WHITE = 0, BLACK = 1, NEUTRAL = 2, NUM_COLORS = 3 };
+
+// Castling bits, same order as Zobrist::castling_rights
+enum CastlingRight : uint8_t {
+    W_KINGSIDE = 1, W_QUEENSIDE = 2, B_KINGSIDE = 4, B_QUEENSIDE = 8
 };
 
+constexpr uint8_t NO_SQUARE = 64;
+
+// Piece types a board can hold; Flock-Chess uses 13
+constexpr int MAX_PIECES = 16;
+constexpr uint8_t NO_PIECE = 0xFF;
+
 struct Bitboards {
-    Bitboard occupancy = 0ULL;
-    Bitboard w_occupancy = 0ULL;
-    Bitboard b_occupancy = 0ULL;
-    std::unordered_map<char, Bitboard> pieceBoards; // keyed by piece letter
+    Bitboard occupancy = 0ULL;      // every piece
+    Bitboard w_occupancy = 0ULL;    // white pieces (upper case)
+    Bitboard b_occupancy = 0ULL;    // black pieces (lower case)
+    Bitboard n_occupancy = 0ULL;    // neutral pieces, e.g. the Flock duck; nobody captures them
+
+    // Piece boards indexed by piece ID. IDs follow the variant's piece list
+    // when the FEN is parsed with one, else the order letters first appear.
+    std::array<Bitboard, MAX_PIECES> pieceBB{};
+    std::array<char, MAX_PIECES> pieceChar{};    // piece ID -> letter
+    uint8_t numPieces = 0;
+    uint16_t neutralTypes = 0;      // bit per piece ID whose pieces are neutral
+    std::array<uint8_t, 64> mailbox = make_empty_mailbox();   // piece ID per square
+
     std::vector<Bitboard> quantum_state;
     bool w_to_move = true;
     bool b_q_castle = true;
@@ -45,8 +104,57 @@ struct Bitboards {
     Bitboard enpassant_sq = 0ULL;
     int halfmove_clock = 0;
     int fullmove_number = 1;
-    uint64_t zobrist_hash = 0ULL;
-    std::unordered_map<uint64_t, int> zobrist_table;
+    int moves_per_turn = 1;         // Move_num: sub-moves before the turn passes
+    int sub_move = 0;               // sub-moves already played this turn
+    uint64_t zobrist_hash = 0ULL;   // earlier positions' hashes live in a History (history.h)
+
+    static constexpr std::array<uint8_t, 64> make_empty_mailbox() {
+        std::array<uint8_t, 64> m{};
+        for (auto& id : m) id = NO_PIECE;
+        return m;
+    }
+
+    int piece_id(char piece) const {
+        for (int id = 0; id < numPieces; id++)
+            if (pieceChar[id] == piece)
+                return id;
+        return -1;
+    }
+
+    // ID of `piece`, registering it if this board has not seen it yet
+    int add_piece_type(char piece) {
+        int id = piece_id(piece);
+        if (id >= 0)
+            return id;
+        if (numPieces == MAX_PIECES)
+            throw std::runtime_error(std::string("Too many piece types, cannot add '") + piece + "'");
+        pieceChar[numPieces] = piece;
+        return numPieces++;
+    }
+
+    void put_piece(char piece, int sq) {
+        int id = add_piece_type(piece);
+        pieceBB[id] |= 1ULL << sq;
+        mailbox[sq] = (uint8_t)id;
+    }
+
+    Bitboard piece_board(char piece) const {
+        int id = piece_id(piece);
+        return id < 0 ? 0ULL : pieceBB[id];
+    }
+
+    // Letter of the piece on sq, or 0 if the square is empty
+    char piece_on(int sq) const {
+        return mailbox[sq] == NO_PIECE ? 0 : pieceChar[mailbox[sq]];
+    }
+
+    // Letter-keyed view for callers written against the old map
+    std::unordered_map<char, Bitboard> pieceBoards() const {
+        std::unordered_map<char, Bitboard> boards;
+        for (int id = 0; id < numPieces; id++)
+            boards[pieceChar[id]] = pieceBB[id];
+        return boards;
+    }
 };
 
 inline void print_bitboard(Bitboard b)
@@ -71,8 +179,11 @@ inline void print_Bitboards(const Bitboards& bb)
     std::cout << "=== Black_Occupancy ===\n";
     print_bitboard(bb.b_occupancy);
     std::cout << "\n";
+    std::cout << "=== Neutral_Occupancy ===\n";
+    print_bitboard(bb.n_occupancy);
+    std::cout << "\n";
 
-    for (const auto& [piece, board] : bb.pieceBoards) {
+    for (const auto& [piece, board] : bb.pieceBoards()) {
         std::cout << "=== Piece " << piece << " ===\n";
         print_bitboard(board);
         std::cout << "\n";
@@ -113,17 +224,14 @@ inline void print_Bitboards(const Bitboards& bb)
 
     // Zobrist hash
     std::cout << "Zobrist hash: " << bb.zobrist_hash << "\n";
-    for (const auto& [hash, reps] : bb.zobrist_table) {
-        std::cout << "=== zobrist_hash " << hash << " ===\n";
-        std::cout << reps << "\n";
-    }
 }
 
 inline std::ostream& operator<<(std::ostream& os, const Bitboards& bb) {
     os << "Occupancy: " << bb.occupancy << "\n";
     os << "White_Occupancy: " << bb.w_occupancy << "\n";
     os << "Black_Occupancy: " << bb.b_occupancy << "\n";
-    for (const auto& [piece, board] : bb.pieceBoards) {
+    os << "Neutral_Occupancy: " << bb.n_occupancy << "\n";
+    for (const auto& [piece, board] : bb.pieceBoards()) {
         os << piece << ": " << board << "\n"; // assumes Bitboard is uint64_t
     }
     // Quantum state (print list of bitboards)
@@ -174,15 +282,40 @@ inline std::ostream& operator<<(std::ostream& os, const Bitboards& bb) {
 
     // Zobrist hash
     os << "Zobrist hash: " << bb.zobrist_hash << "\n";
-    for (const auto& [hash, reps] : bb.zobrist_table) {
-        os << "=== zobrist_hash " << hash << " ===\n";
-        os << reps << "\n";
-    }
     return os;
 }
 
+// Upper-case letters are white, lower-case black. A '+' before a letter, or
+// the letter being listed in `neutrals`, makes that piece neutral.
 Bitboards parse_fen_bitboards(const std::string& fen);
-std::array<uint64_t,64> movegen(const Bitboards& bb, const std::unordered_map<char,std::string>& piece_to_expr);
+// Same, with piece IDs taken from the variant's piece list
+Bitboards parse_fen_bitboards(const std::string& fen, const std::vector<char>& pieces,
+                              const std::vector<char>& neutrals = {});
+void init_zobrist(Zobrist& z, const std::vector<char>& piece_list, size_t num_quantum_layers);
+uint64_t compute_zobrist(const Bitboards& bb, const Zobrist& table);
+// Targets of every piece, indexed by its square
+using MoveBoards = std::array<Bitboard, 64>;
+
+// Pseudo-move targets split by kind. A quiet target is empty; a capture
+// target holds an enemy piece (white vs black). Neutral pieces never
+// capture and are never captured, and every piece blocks. Pawn programs
+// (code 17 / 20 alone) capture diagonally, en passant included, and push
+// one or two squares straight ahead. A king with a castling right adds its
+// castling square once the path is empty (see castling.h).
+struct MoveTargets {
+    MoveBoards quiet;
+    MoveBoards captures;
+};
+
+enum GenType { QUIETS = 1, CAPTURES = 2, ALL_MOVES = QUIETS | CAPTURES };
+
+// One pass over all pieces into the caller's buffer; no heap allocation.
+// Boards of a kind not asked for are left zeroed.
+void movegen(const Bitboards& bb, const PiecePrograms& programs, MoveTargets& out,
+             GenType type = ALL_MOVES);
+// Quiet and capture targets merged
+void movegen(const Bitboards& bb, const PiecePrograms& programs, MoveBoards& out);
+MoveBoards movegen(const Bitboards& bb, const PiecePrograms& programs);
 // std::array<uint64_t, 64> generate_from_fen(const std::string& fen, const std::string& mode);
 // Initialize all move generators (magics, lookup tables, etc.)
 uint64_t init_moves();
\ No newline at end of file
@@ -0,0 +1,196 @@
+#include "movepick.h"
+#include <algorithm>
+#include <utility>
+
+MovePicker::MovePicker(const Bitboards& bb, const GameRules& rules, const Evaluator& ev,
+                       const PieceToTable<int>& history, Move ttMove, const Move killers[2], Move counter,
+                       uint64_t* jitter)
+    : bb(bb), rules(rules), ev(ev), history(&history), jitter(jitter), ttMove(ttMove),
+      refutations{ killers[0], killers[1], counter } {
+    // Only quiet moves are refutations; drop repeats
+    for (int i = 0; i < 3; i++) {
+        Move& r = refutations[i];
+        if (r == ttMove || move_is_capture(r))
+            r = NO_MOVE;
+        for (int j = 0; j < i; j++)
+            if (r == refutations[j])
+                r = NO_MOVE;
+    }
+}
+
+MovePicker::MovePicker(const Bitboards& bb, const GameRules& rules, const Evaluator& ev, Move ttMove)
+    : bb(bb), rules(rules), ev(ev), history(nullptr), jitter(nullptr),
+      ttMove(move_is_capture(ttMove) || move_type(ttMove) == PROMOTION ? ttMove : NO_MOVE),
+      refutations{ NO_MOVE, NO_MOVE, NO_MOVE } {}
+
+bool MovePicker::contains(const MoveList& list, Move m) {
+    for (Move x : list)
+        if (x == m)
+            return true;
+    return false;
+}
+
+bool MovePicker::is_refutation(Move m) const {
+    return m == refutations[0] || m == refutations[1] || m == refutations[2];
+}
+
+Move MovePicker::pick_best(MoveList& list, int* scores, int cur) {
+    int best = cur;
+    for (int i = cur + 1; i < list.size; i++)
+        if (scores[i] > scores[best])
+            best = i;
+    std::swap(list.moves[cur], list.moves[best]);
+    std::swap(scores[cur], scores[best]);
+    return list.moves[cur];
+}
+
+void MovePicker::score_captures() {
+    for (int i = 0; i < captures.size; i++) {
+        Move m = captures.moves[i];
+        uint8_t victim = bb.mailbox[move_to(m)];
+        int victimValue = victim == NO_PIECE ? 100                      // en passant
+                        : ev.king[victim] ? 20000 : ev.value[victim];   // a Flock king is the game
+        int score = 16 * victimValue - ev.value[bb.mailbox[move_from(m)]] / 16;
+        if (move_type(m) == PROMOTION)
+            score += ev.value[move_promo(m)];
+        captureScores[i] = score;
+    }
+}
+
+void MovePicker::score_quiets() {
+    for (int i = 0; i < quiets.size; i++) {
+        Move m = quiets.moves[i];
+        int score = (*history)[bb.mailbox[move_from(m)]][move_to(m)];
+        if (move_type(m) == PROMOTION)
+            score += 1 << 20;
+        if (jitter) {
+            uint64_t& x = *jitter;
+            x ^= x << 13, x ^= x >> 7, x ^= x << 17;
+            score += static_cast<int>(x & 255);
+        }
+        quietScores[i] = score;
+    }
+}
+
+Move MovePicker::next() {
+    switch (stage) {
+    case TT_MOVE:
+        stage = CAPTURES_INIT;
+        if (ttMove != NO_MOVE) {
+            // A capture is checked against the capture list, which the next
+            // stage needs anyway; a quiet move on its own
+            bool valid;
+            if (move_is_capture(ttMove)) {
+                generate_moves(bb, rules, captures, CAPTURES);
+                capturesReady = true;
+                valid = contains(captures, ttMove);
+            } else {
+                valid = is_quiet_move(bb, rules, ttMove);
+            }
+            // Quiescence prunes losing exchanges, the TT move's included
+            if (valid && (history || see(bb, rules, ev, ttMove) >= 0))
+                return ttMove;
+            ttMove = NO_MOVE;
+        }
+        [[fallthrough]];
+
+    case CAPTURES_INIT:
+        if (!capturesReady)
+            generate_moves(bb, rules, captures, CAPTURES);
+        score_captures();
+        cur = 0;
+        stage = GOOD_CAPTURES;
+        [[fallthrough]];
+
+    case GOOD_CAPTURES:
+        while (cur < captures.size) {
+            Move m = pick_best(captures, captureScores, cur++);
+            if (m == ttMove)
+                continue;
+            if (see(bb, rules, ev, m) >= 0)
+                return m;
+            if (history)
+                captures.moves[badCaptures++] = m;
+        }
+        if (!history) {
+            stage = QS_PROMOTIONS_INIT;
+            return next();
+        }
+        stage = QUIETS_INIT;
+        [[fallthrough]];
+
+    case QUIETS_INIT:
+        generate_moves(bb, rules, quiets, QUIETS);
+        for (Move& r : refutations)
+            if (r != NO_MOVE && !contains(quiets, r))
+                r = NO_MOVE;
+        stage = KILLER_1;
+        [[fallthrough]];
+
+    case KILLER_1:
+    case KILLER_2:
+    case COUNTER_MOVE:
+        while (stage <= COUNTER_MOVE) {
+            Move r = refutations[stage - KILLER_1];
+            stage = static_cast<Stage>(stage + 1);
+            if (r != NO_MOVE)
+                return r;
+        }
+        [[fallthrough]];
+
+    case QUIETS_SORT:
+        score_quiets();
+        cur = 0;
+        stage = QUIET_MOVES;
+        [[fallthrough]];
+
+    case QUIET_MOVES:
+        while (cur < quiets.size) {
+            Move m = pick_best(quiets, quietScores, cur++);
+            if (m != ttMove && !is_refutation(m))
+                return m;
+        }
+        cur = 0;
+        stage = BAD_CAPTURES;
+        [[fallthrough]];
+
+    case BAD_CAPTURES:
+        if (cur < badCaptures)
+            return captures.moves[cur++];
+        stage = DONE;
+        return NO_MOVE;
+
+    case QS_PROMOTIONS_INIT: {
+        // Quiet pushes onto the last rank, generated only when a pawn has
+        // one: the most valuable piece, if SEE says it survives
+        const bool white = bb.w_to_move;
+        const Bitboard pawns = bb.piece_board(white ? 'P' : 'p');
+        quiets.clear();
+        if (pawn_pushes(pawns, ~bb.occupancy, white) & pawn_promotion_rank(white))
+            generate_moves(bb, rules, quiets, QUIETS);
+        int best = 0;
+        for (Move m : quiets)
+            if (move_type(m) == PROMOTION)
+                best = std::max(best, ev.value[move_promo(m)]);
+        int kept = 0;
+        for (Move m : quiets)
+            if (move_type(m) == PROMOTION && ev.value[move_promo(m)] == best && m != ttMove
+                && see(bb, rules, ev, m) >= 0)
+                quiets.moves[kept++] = m;
+        quiets.size = kept;
+        cur = 0;
+        stage = QS_PROMOTIONS;
+    }
+        [[fallthrough]];
+
+    case QS_PROMOTIONS:
+        if (cur < quiets.size)
+            return quiets.moves[cur++];
+        stage = DONE;
+        [[fallthrough]];
+
+    case DONE:
+        break;
+    }
+    return NO_MOVE;
+}
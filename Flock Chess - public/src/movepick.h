@@ -0,0 +1,78 @@
+// movepick.h
+#pragma once
+#include <array>
+#include "see.h"
+
+// =====================================================
+// Staged move picker
+// =====================================================
+/*
+  Hands out a node's moves best-first, generating them only as the
+  stages are reached:
+    1. the TT move
+    2. captures that do not lose material by SEE, most valuable victim
+       first, least valuable attacker breaking ties
+    3. the two killers of this ply, then the counter-move to the last move
+    4. the other quiet moves by history score
+    5. the captures SEE says lose material
+  A cutoff in stage 1 or 2 never generates the quiet moves. Killers,
+  counter-move and TT move come from other positions, so each is handed
+  out only if this position's generator would produce it: a quiet TT move
+  is checked on its own (is_quiet_move), the others against the lists.
+
+  The quiescence picker hands out stage 2, then the quiet promotions to
+  the most valuable piece. Losing captures and promotions are pruned
+  there, a losing TT move included.
+
+  History and counter-move tables are indexed by the moving piece's ID and
+  the target square. IDs are dense per variant (Bitboards::pieceChar), so
+  one table shape serves the standard set, Flock's duck and any fairy set.
+*/
+template <typename T>
+using PieceToTable = std::array<std::array<T, 64>, MAX_PIECES>;
+
+class MovePicker {
+public:
+    // `jitter`, when given, is a xorshift state adding noise to quiet
+    // scores (Lazy SMP helpers)
+    MovePicker(const Bitboards& bb, const GameRules& rules, const Evaluator& ev,
+               const PieceToTable<int>& history, Move ttMove, const Move killers[2], Move counter,
+               uint64_t* jitter = nullptr);
+    // Quiescence: the TT move if it is a capture or promotion, stage 2,
+    // then quiet promotions
+    MovePicker(const Bitboards& bb, const GameRules& rules, const Evaluator& ev, Move ttMove);
+
+    // NO_MOVE once every move has been returned
+    Move next();
+
+private:
+    enum Stage {
+        TT_MOVE, CAPTURES_INIT, GOOD_CAPTURES, QUIETS_INIT, KILLER_1, KILLER_2, COUNTER_MOVE,
+        QUIETS_SORT, QUIET_MOVES, BAD_CAPTURES, QS_PROMOTIONS_INIT, QS_PROMOTIONS, DONE
+    };
+
+    void score_captures();
+    void score_quiets();
+    bool is_refutation(Move m) const;
+    static bool contains(const MoveList& list, Move m);
+    // Swaps the best-scored move in [cur, size) to cur and returns it
+    static Move pick_best(MoveList& list, int* scores, int cur);
+
+    const Bitboards& bb;
+    const GameRules& rules;
+    const Evaluator& ev;
+    const PieceToTable<int>* history;       // null: quiescence
+    uint64_t* jitter;
+
+    Move ttMove;
+    Move refutations[3];            // killer 1, killer 2, counter-move
+    Stage stage = TT_MOVE;
+    int cur = 0;
+    int badCaptures = 0;            // losing captures, kept at the front of `captures`
+    bool capturesReady = false;
+
+    MoveList captures;
+    MoveList quiets;
+    int captureScores[MAX_MOVES];
+    int quietScores[MAX_MOVES];
+};
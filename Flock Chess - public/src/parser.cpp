@@ -19,6 +19,14 @@ std::vector<char> parsePieceList(const std::string& s) {
             pieces.push_back(c);
     return pieces;
 }
+// Letters written with a '+' in front, e.g. the D in Pieces=KQRBNPkqrbnp+D
+std::vector<char> parseNeutralPieces(const std::string& s) {
+    std::vector<char> neutrals;
+    for (size_t i = 0; i + 1 < s.size(); ++i)
+        if (s[i] == '+' && !isspace(s[i + 1]) && s[i + 1] != '+')
+            neutrals.push_back(s[i + 1]);
+    return neutrals;
+}
 std::vector<std::string> parseMovesetList(const std::string& s) {
     std::vector<std::string> moves;
 
@@ -41,6 +49,25 @@ std::vector<std::string> parseMovesetList(const std::string& s) {
     return moves;
 }
 
+// Keeps the Moveset text per piece and compiles it once for movegen
+void assignMovesets(Variant& v, const std::vector<std::string>& moveset) {
+    for (size_t i = 0; i < v.pieces.size(); ++i) {
+        char piece = v.pieces[i];
+        v.movesets[piece] = moveset[i];
+        if (static_cast<unsigned char>(piece) >= v.programs.size()) {
+            std::cerr << "Error: Piece '" << piece << "' is not ASCII in variant "
+                      << v.gameMode << "\n";
+            continue;
+        }
+        try {
+            v.programs[piece] = compile_moveset(moveset[i]);
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << " for piece '" << piece
+                      << "' in variant " << v.gameMode << "\n";
+        }
+    }
+}
+
 std::unordered_map<std::string, Variant>
 parseVariantsINI(const std::string& iniText)
 {
@@ -87,6 +114,7 @@ parseVariantsINI(const std::string& iniText)
         // Assign to strict fields
         if (key == "Pieces") {
             cur->pieces = parsePieceList(val);
+            cur->neutralPieces = parseNeutralPieces(val);
 
             // If moveset was seen earlier, build the map now
             if (movesetPending && !pendingMoveset.empty()) {
@@ -94,9 +122,7 @@ parseVariantsINI(const std::string& iniText)
                     std::cerr << "Error: Mismatched Pieces and Moveset count in variant "
                               << cur->gameMode << "\n";
                 } else {
-                    for (size_t i = 0; i < cur->pieces.size(); ++i) {
-                        cur->movesets[cur->pieces[i]] = pendingMoveset[i];
-                    }
+                    assignMovesets(*cur, pendingMoveset);
                 }
                 movesetPending = false;
             }
@@ -110,9 +136,7 @@ parseVariantsINI(const std::string& iniText)
                     std::cerr << "Error: Mismatched Pieces and Moveset count in variant "
                               << cur->gameMode << "\n";
                 } else {
-                    for (size_t i = 0; i < cur->pieces.size(); ++i) {
-                        cur->movesets[cur->pieces[i]] = pendingMoveset[i];
-                    }
+                    assignMovesets(*cur, pendingMoveset);
                 }
             } else {
                 movesetPending = true;  // wait until pieces appear
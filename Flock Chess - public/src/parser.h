@@ -4,13 +4,16 @@
 #include <string>
 #include <vector>
 #include <unordered_map>
+#include "bitboards/attacks.h"
 
 struct Variant {
     std::string gameMode;               // [Section]
 
     std::vector<char> pieces;           // Pieces=KQRBNPD
+    std::vector<char> neutralPieces;    // letters marked '+' in Pieces= (Flock duck)
     std::unordered_map<char, std::string> movesets;  
                                         // Moveset=[16, 1+2+3, 1, 2, 3, 17]
+    PiecePrograms programs;             // movesets compiled, indexed by piece letter
 
     std::string effects;                // Effects=Flock, Quantum, Powerup (optional)
     std::string board;                  // Board=8x8
@@ -0,0 +1,96 @@
+#include "perft.h"
+#include <thread>
+
+PerftHash::PerftHash(size_t megabytes) {
+    size_t entries = 1;
+    while (entries * 2 * sizeof(Entry) <= megabytes * 1024 * 1024)
+        entries *= 2;
+    table.reset(new Entry[entries]());
+    mask = entries - 1;
+}
+
+// Depth folded into the key, so one position stores a count per depth
+static uint64_t depth_key(uint64_t key, int depth) {
+    return key ^ (0x9E3779B97F4A7C15ULL * static_cast<uint64_t>(depth + 1));
+}
+
+bool PerftHash::probe(uint64_t key, int depth, uint64_t& nodes) const {
+    uint64_t k = depth_key(key, depth);
+    const Entry& e = table[k & mask];
+    uint64_t n = e.nodes.load(std::memory_order_relaxed);
+    if ((e.check.load(std::memory_order_relaxed) ^ n) != k)
+        return false;
+    nodes = n;
+    return true;
+}
+
+void PerftHash::store(uint64_t key, int depth, uint64_t nodes) {
+    uint64_t k = depth_key(key, depth);
+    Entry& e = table[k & mask];
+    e.check.store(k ^ nodes, std::memory_order_relaxed);
+    e.nodes.store(nodes, std::memory_order_relaxed);
+}
+
+uint64_t perft(Bitboards& bb, const GameRules& rules, const Zobrist& z, int depth, PerftHash* hash) {
+    if (depth == 0)
+        return 1;
+
+    // Depth 1 is a bulk count, cheaper than a probe; deeper, a hit saves
+    // the move generation too
+    uint64_t nodes = 0;
+    if (depth > 1 && hash && hash->probe(bb.zobrist_hash, depth, nodes))
+        return nodes;
+
+    MoveList list;
+    generate_moves(bb, rules, list);
+    if (depth == 1)
+        return list.size;
+
+    for (Move m : list) {
+        UndoInfo undo;
+        play_move(bb, m, undo, z, rules);
+        nodes += perft(bb, rules, z, depth - 1, hash);
+        unmake_move(bb, m, undo);
+    }
+
+    if (hash)
+        hash->store(bb.zobrist_hash, depth, nodes);
+    return nodes;
+}
+
+PerftResult perft_divide(const Bitboards& bb, const GameRules& rules, const Zobrist& z, int depth,
+                         int threads, PerftHash* hash) {
+    PerftResult result;
+    if (depth <= 0) {
+        result.nodes = 1;
+        return result;
+    }
+
+    MoveList list;
+    generate_moves(bb, rules, list);
+    result.divide.resize(list.size);
+
+    // Workers take root moves one at a time from a shared counter
+    std::atomic<int> next{ 0 };
+    auto worker = [&]() {
+        Bitboards local = bb;
+        for (int i = next++; i < list.size; i = next++) {
+            Move m = list.moves[i];
+            UndoInfo undo;
+            play_move(local, m, undo, z, rules);
+            result.divide[i] = { m, perft(local, rules, z, depth - 1, hash) };
+            unmake_move(local, m, undo);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; t++)
+        pool.emplace_back(worker);
+    worker();
+    for (std::thread& t : pool)
+        t.join();
+
+    for (const auto& [m, nodes] : result.divide)
+        result.nodes += nodes;
+    return result;
+}
@@ -0,0 +1,46 @@
+// perft.h
+#pragma once
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "rules.h"
+
+// =====================================================
+// Perft
+// =====================================================
+/*
+  Counts the leaf nodes of the move tree to a fixed depth (in sub-moves,
+  so a Flock turn is two plies). Root moves are split over a pool of
+  threads, each with its own copy of the board. An optional PerftHash,
+  shared by all threads, remembers subtree counts by position and depth.
+*/
+class PerftHash {
+public:
+    explicit PerftHash(size_t megabytes);
+
+    bool probe(uint64_t key, int depth, uint64_t& nodes) const;
+    void store(uint64_t key, int depth, uint64_t nodes);
+
+private:
+    // Written without locks: check holds key ^ nodes, so an entry torn by
+    // two writers fails the probe instead of returning a wrong count
+    struct Entry {
+        std::atomic<uint64_t> check;
+        std::atomic<uint64_t> nodes;
+    };
+
+    std::unique_ptr<Entry[]> table;
+    size_t mask;
+};
+
+uint64_t perft(Bitboards& bb, const GameRules& rules, const Zobrist& z, int depth,
+               PerftHash* hash = nullptr);
+
+struct PerftResult {
+    uint64_t nodes = 0;
+    std::vector<std::pair<Move, uint64_t>> divide;   // per root move, in generation order
+};
+
+PerftResult perft_divide(const Bitboards& bb, const GameRules& rules, const Zobrist& z, int depth,
+                         int threads = 1, PerftHash* hash = nullptr);
@@ -0,0 +1,53 @@
+// perft: node counts for a variant and FEN, with a per-move divide
+//
+// Usage: perft <variant> "<fen>|startpos" <depth> [threads] [hash MB] [variants.ini]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include "perft.h"
+
+int main(int argc, char* argv[]) {
+    if (argc < 4) {
+        std::fprintf(stderr, "Usage: perft <variant> \"<fen>|startpos\" <depth> [threads] [hash MB] [variants.ini]\n");
+        return 1;
+    }
+    std::string gameMode = argv[1];
+    std::string fen = argv[2];
+    int depth = std::atoi(argv[3]);
+    int threads = argc > 4 ? std::max(1, std::atoi(argv[4])) : 1;
+    int hashMb = argc > 5 ? std::atoi(argv[5]) : 0;
+    std::string ini = argc > 6 ? argv[6] : "../variants.ini";
+
+    auto variants = parse(ini);
+    auto it = variants.find(gameMode);
+    if (it == variants.end()) {
+        std::fprintf(stderr, "Error: Variant '%s' not found in %s\n", gameMode.c_str(), ini.c_str());
+        return 1;
+    }
+    const Variant& v = it->second;
+    if (fen == "startpos")
+        fen = v.stdPos;
+
+    init_attack_tables();
+    GameRules rules = rules_for(v);
+    Zobrist z;
+    init_zobrist(z, v.pieces, 0);
+    Bitboards bb = setup_board(v, rules, fen);
+    bb.zobrist_hash = compute_zobrist(bb, z);
+
+    std::unique_ptr<PerftHash> hash;
+    if (hashMb > 0)
+        hash = std::make_unique<PerftHash>(static_cast<size_t>(hashMb));
+
+    auto t0 = std::chrono::steady_clock::now();
+    PerftResult result = perft_divide(bb, rules, z, depth, threads, hash.get());
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    for (const auto& [m, nodes] : result.divide)
+        std::printf("%s: %llu\n", move_to_string(bb, m).c_str(), (unsigned long long)nodes);
+    std::printf("\nNodes: %llu\nTime: %.3f s\nNPS: %.0f\n",
+                (unsigned long long)result.nodes, secs, secs > 0 ? result.nodes / secs : 0.0);
+    return 0;
+}
@@ -0,0 +1,91 @@
+#include "position.h"
+#include <cctype>
+#include <stdexcept>
+
+static char fold(char piece) {
+    return static_cast<char>(std::tolower(static_cast<unsigned char>(piece)));
+}
+
+int Position::type_of(char piece) const {
+    char letter = fold(piece);
+    for (int t = 0; t < numTypes; t++)
+        if (typeChar[t] == letter)
+            return t;
+    return -1;
+}
+
+void Position::move_piece(int from, int to) {
+    Bitboard fromTo = (1ULL << from) | (1ULL << to);
+    for (int t = 0; t < numTypes; t++)
+        if (byType[t] & (1ULL << from))
+            byType[t] ^= fromTo;
+    for (int c = 0; c < NUM_COLORS; c++)
+        if (byColor[c] & (1ULL << from))
+            byColor[c] ^= fromTo;
+}
+
+Position to_position(const Bitboards& bb) {
+    Position pos{};
+
+    for (int id = 0; id < bb.numPieces; id++) {
+        char piece = bb.pieceChar[id];
+        Bitboard board = bb.pieceBB[id];
+
+        int t = pos.type_of(piece);
+        if (t < 0) {
+            if (pos.numTypes == MAX_PIECE_TYPES)
+                throw std::runtime_error(std::string("Too many piece types for Position at '") + piece + "'");
+            t = pos.numTypes++;
+            pos.typeChar[t] = fold(piece);
+        }
+        pos.byType[t] |= board;
+
+        // Colour is per square: a neutral marker overrides the letter case
+        pos.byColor[NEUTRAL] |= board & bb.n_occupancy;
+        pos.byColor[WHITE] |= board & bb.w_occupancy;
+        pos.byColor[BLACK] |= board & bb.b_occupancy;
+    }
+
+    pos.hash = bb.zobrist_hash;
+    pos.halfmoveClock = static_cast<uint16_t>(bb.halfmove_clock);
+    pos.fullmoveNumber = static_cast<uint16_t>(bb.fullmove_number);
+    pos.castling = (bb.w_k_castle ? W_KINGSIDE : 0) | (bb.w_q_castle ? W_QUEENSIDE : 0)
+                 | (bb.b_k_castle ? B_KINGSIDE : 0) | (bb.b_q_castle ? B_QUEENSIDE : 0);
+    pos.epSquare = bb.enpassant_sq ? static_cast<uint8_t>(indexLSB(bb.enpassant_sq)) : NO_SQUARE;
+    pos.whiteToMove = bb.w_to_move;
+    return pos;
+}
+
+Bitboards to_bitboards(const Position& pos) {
+    Bitboards bb;
+    for (int t = 0; t < pos.numTypes; t++) {
+        char lower = pos.typeChar[t];
+        char upper = static_cast<char>(std::toupper(static_cast<unsigned char>(lower)));
+        // White and neutral pieces use the upper-case letter, as in the FEN
+        Bitboard whiteSide = pos.byType[t] & (pos.byColor[WHITE] | pos.byColor[NEUTRAL]);
+        Bitboard blackSide = pos.byType[t] & pos.byColor[BLACK];
+
+        for (Bitboard b = whiteSide; b; b &= b - 1)
+            bb.put_piece(upper, indexLSB(b));
+        if (pos.byType[t] & pos.byColor[NEUTRAL])
+            bb.neutralTypes |= 1u << bb.piece_id(upper);
+        for (Bitboard b = blackSide; b; b &= b - 1)
+            bb.put_piece(lower, indexLSB(b));
+    }
+
+    bb.occupancy = pos.occupied();
+    bb.w_occupancy = pos.byColor[WHITE];
+    bb.b_occupancy = pos.byColor[BLACK];
+    bb.n_occupancy = pos.byColor[NEUTRAL];
+
+    bb.zobrist_hash = pos.hash;
+    bb.halfmove_clock = pos.halfmoveClock;
+    bb.fullmove_number = pos.fullmoveNumber;
+    bb.w_k_castle = pos.castling & W_KINGSIDE;
+    bb.w_q_castle = pos.castling & W_QUEENSIDE;
+    bb.b_k_castle = pos.castling & B_KINGSIDE;
+    bb.b_q_castle = pos.castling & B_QUEENSIDE;
+    bb.enpassant_sq = pos.epSquare == NO_SQUARE ? 0ULL : 1ULL << pos.epSquare;
+    bb.w_to_move = pos.whiteToMove;
+    return bb;
+}
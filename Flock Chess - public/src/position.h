@@ -0,0 +1,55 @@
+// position.h
+#pragma once
+#include <cstdint>
+#include <type_traits>
+#include "movegen.h"
+
+// =====================================================
+// Compact position
+// =====================================================
+/*
+  Fixed-size, trivially copyable snapshot of a board for copy-make search
+  and batch work: copying one is a 112-byte memcpy with no allocation.
+  Pieces are stored by type (the letter case-folded, so 'N' and 'n' share
+  a board) and by colour, the usual bitboard split; a piece's boards are
+  byType[t] & byColor[c]. Type letters are kept in the struct, so a
+  Position converts back to Bitboards without its variant.
+
+  Not carried over: quantum layers and the repetition table, which stay in
+  Bitboards.
+*/
+constexpr int MAX_PIECE_TYPES = 8;
+
+struct Position {
+    Bitboard byType[MAX_PIECE_TYPES];
+    Bitboard byColor[NUM_COLORS];
+    uint64_t hash;
+    char typeChar[MAX_PIECE_TYPES];     // lowercase letter per type, 0 if unused
+    uint16_t halfmoveClock;
+    uint16_t fullmoveNumber;
+    uint8_t numTypes;
+    uint8_t castling;                   // CastlingRight bits
+    uint8_t epSquare;                   // NO_SQUARE if none
+    uint8_t whiteToMove;
+
+    Bitboard occupied() const {
+        return byColor[WHITE] | byColor[BLACK] | byColor[NEUTRAL];
+    }
+
+    Bitboard pieces(int type, int color) const {
+        return byType[type] & byColor[color];
+    }
+
+    // Type index of a letter (either case), or -1
+    int type_of(char piece) const;
+
+    // Moves whatever stands on `from` to `to`; `to` must be empty
+    void move_piece(int from, int to);
+};
+
+static_assert(std::is_trivially_copyable<Position>::value, "Position must stay memcpy-able");
+static_assert(sizeof(Position) <= 128, "Position should fit in two cache lines");
+
+// Throws std::runtime_error if the board has more than MAX_PIECE_TYPES types
+Position to_position(const Bitboards& bb);
+Bitboards to_bitboards(const Position& pos);
@@ -0,0 +1,185 @@
+#include "rules.h"
+#include "castling.h"
+#include <algorithm>
+
+GameRules rules_for(const Variant& v) {
+    GameRules rules;
+    rules.flock = v.effects == "Flock";
+    rules.movesPerTurn = rules.flock ? 2 : std::max(1, v.move_num);
+    rules.checkEndsTurn = !rules.flock && rules.movesPerTurn > 1;
+    rules.programs = &v.programs;
+    return rules;
+}
+
+Bitboards setup_board(const Variant& v, const GameRules& rules, const std::string& fen) {
+    Bitboards bb = parse_fen_bitboards(fen, v.pieces, v.neutralPieces);
+    bb.moves_per_turn = rules.movesPerTurn;
+    return bb;
+}
+
+static bool is_king(char c) {
+    return c == 'K' || c == 'k';
+}
+
+void generate_piece_moves(const Bitboards& bb, const PiecePrograms& programs, MoveList& list, GenType type) {
+    list.clear();
+
+    MoveTargets targets;
+    movegen(bb, programs, targets, type);
+
+    const bool white = bb.w_to_move;
+    const PromotionSet promos = promotion_pieces(bb, white);
+    const Bitboard last = pawn_promotion_rank(white);
+
+    for (Bitboard b = white ? bb.w_occupancy : bb.b_occupancy; b; b &= b - 1) {
+        int from = indexLSB(b);
+        char piece = bb.piece_on(from);
+        bool pawn = programs[static_cast<unsigned char>(piece)].pawn != 0;
+
+        for (Bitboard t = targets.quiet[from] | targets.captures[from]; t; t &= t - 1) {
+            int to = indexLSB(t);
+            Bitboard toBit = 1ULL << to;
+            bool capture = targets.captures[from] & toBit;
+
+            if (pawn && (toBit & last)) {
+                for (int i = 0; i < promos.count; i++)
+                    list.push(make_move_code(from, to, PROMOTION, capture, promos.ids[i]));
+            } else if (pawn && (toBit & bb.enpassant_sq & ~bb.occupancy)) {
+                list.push(make_move_code(from, to, EN_PASSANT, true));
+            } else if (pawn && (to - from == 16 || from - to == 16)) {
+                list.push(make_move_code(from, to, DOUBLE_PUSH));
+            } else if (is_king(piece) && (to - from == 2 || from - to == 2)) {
+                list.push(make_move_code(from, to, to > from ? CASTLE_KING : CASTLE_QUEEN));
+            } else {
+                list.push(make_move_code(from, to, NORMAL, capture));
+            }
+        }
+    }
+}
+
+void generate_neutral_moves(const Bitboards& bb, const PiecePrograms& programs, MoveList& list) {
+    list.clear();
+    for (Bitboard b = bb.n_occupancy; b; b &= b - 1) {
+        int from = indexLSB(b);
+        const AttackProgram& program = programs[static_cast<unsigned char>(bb.piece_on(from))];
+        if (program.count == 0)
+            continue;
+        for (Bitboard t = program(from, bb.occupancy) & ~bb.occupancy; t; t &= t - 1)
+            list.push(make_move_code(from, indexLSB(t)));
+    }
+}
+
+void generate_moves(const Bitboards& bb, const GameRules& rules, MoveList& list, GenType type) {
+    if (!rules.flock) {
+        generate_legal(bb, list, type);
+        return;
+    }
+    // A captured king ends the game
+    if (!bb.piece_board('K') || !bb.piece_board('k')) {
+        list.clear();
+        return;
+    }
+    if (bb.sub_move == 0)
+        generate_piece_moves(bb, *rules.programs, list, type);
+    else if (type & QUIETS)
+        generate_neutral_moves(bb, *rules.programs, list);
+    else
+        list.clear();
+}
+
+bool is_quiet_move(const Bitboards& bb, const GameRules& rules, Move m) {
+    if (!rules.flock)
+        return is_legal_quiet(bb, m);
+
+    const int from = move_from(m), to = move_to(m);
+    const Bitboard fromBit = 1ULL << from, toBit = 1ULL << to;
+    const Bitboard occ = bb.occupancy;
+    if ((occ & toBit) || !bb.piece_board('K') || !bb.piece_board('k'))
+        return false;
+
+    const char piece = bb.piece_on(from);
+    const AttackProgram& program = (*rules.programs)[static_cast<unsigned char>(piece)];
+    const bool white = bb.w_to_move;
+    const Bitboard movers = bb.sub_move == 0 ? (white ? bb.w_occupancy : bb.b_occupancy) : bb.n_occupancy;
+    if (!(movers & fromBit) || program.count == 0)
+        return false;
+
+    if (program.pawn)
+        return is_pawn_push(bb, m, program.pawn == PAWN_WHITE);
+    if (is_king(piece) && (to - from == 2 || from - to == 2)) {
+        // Labelled castling by distance, as generate_piece_moves does
+        const CastlingPath& c = castling_path(to > from ? CASTLE_KING : CASTLE_QUEEN, from);
+        bool castle = from == c.kingFrom && to == c.kingTo && (castling_bits(bb) & c.right)
+                   && !(occ & c.empty) && bb.piece_on(c.rookFrom) == (white ? 'R' : 'r');
+        return m == make_move_code(from, to, c.type) && (castle || (program(from, occ) & toBit));
+    }
+    return m == make_move_code(from, to) && (program(from, occ) & toBit);
+}
+
+void play_move(Bitboards& bb, Move m, UndoInfo& undo, const Zobrist& z, const GameRules& rules) {
+    const bool mover = bb.w_to_move;
+    make_move(bb, m, undo, z);
+    if (!rules.checkEndsTurn || bb.w_to_move != mover || !king_in_check(bb, !mover))
+        return;
+
+    // Check: the turn passes now. unmake_move restores all of this from undo.
+    bb.zobrist_hash ^= z.sub_move[bb.sub_move % ZOBRIST_SUB_MOVES] ^ z.sub_move[0] ^ z.side_to_move;
+    bb.sub_move = 0;
+    if (!mover)
+        bb.fullmove_number++;
+    bb.w_to_move = !mover;
+}
+
+int repetition_stride(const GameRules& rules) {
+    return rules.checkEndsTurn ? 1 : 2 * rules.movesPerTurn;
+}
+
+int fifty_move_limit(const GameRules& rules) {
+    return 100 * (rules.flock ? 1 : rules.movesPerTurn);
+}
+
+bool is_draw(const Bitboards& bb, const GameRules& rules, const History& history, int repeats) {
+    if (bb.halfmove_clock >= fifty_move_limit(rules))
+        return true;
+    // Entries since the last clock reset: one per tick, plus the neutral
+    // sub-moves in between for Flock
+    int window = rules.flock ? 2 * bb.halfmove_clock + bb.sub_move : bb.halfmove_clock;
+    return history.repetitions(window, repetition_stride(rules)) >= repeats;
+}
+
+Bitboard attackers_to(const Bitboards& bb, const GameRules& rules, int sq, Bitboard occ) {
+    if (!rules.flock)
+        return attackers_to(bb, sq, occ);
+
+    const Bitboard target = 1ULL << sq;
+    Bitboard result = 0ULL;
+    for (int id = 0; id < bb.numPieces; id++) {
+        Bitboard pieces = bb.pieceBB[id];
+        if (!pieces || ((bb.neutralTypes >> id) & 1))
+            continue;
+        const AttackProgram& program = (*rules.programs)[static_cast<unsigned char>(bb.pieceChar[id])];
+        if (program.reversible) {
+            result |= program.reverse(sq, occ) & pieces;
+            continue;
+        }
+        for (; pieces; pieces &= pieces - 1) {
+            int from = indexLSB(pieces);
+            if (program(from, occ) & target)
+                result |= pieces & -pieces;
+        }
+    }
+    return result;
+}
+
+static std::string square_name(int sq) {
+    return { static_cast<char>('a' + sq % 8), static_cast<char>('1' + sq / 8) };
+}
+
+std::string move_to_string(const Bitboards& bb, Move m) {
+    std::string s = square_name(move_from(m)) + square_name(move_to(m));
+    if (move_type(m) == PROMOTION)
+        s += bb.pieceChar[move_promo(m)];
+    if (move_has_duck(m))
+        s += "/" + square_name(move_duck_from(m)) + square_name(move_duck_to(m));
+    return s;
+}
@@ -0,0 +1,70 @@
+// rules.h
+#pragma once
+#include "legal.h"
+#include "parser.h"
+#include "history.h"
+
+// =====================================================
+// Per-variant move rules
+// =====================================================
+/*
+  One entry point for "the moves of this position" whatever the variant:
+    standard rules  generate_legal(); Move_num > 1 (Marseillais) plays
+                    that many legal moves before the turn passes, except
+                    that a sub-move giving check ends the turn at once
+    Flock           no check: kings may be left attacked and are captured,
+                    which ends the game. A turn is two sub-moves, a piece
+                    move from the compiled Moveset programs and then one
+                    neutral piece (duck) moving by its own program.
+  Once a Flock king is gone the game is over and there are no moves.
+*/
+struct GameRules {
+    bool flock = false;
+    int movesPerTurn = 1;
+    bool checkEndsTurn = false;                 // Marseillais
+    const PiecePrograms* programs = nullptr;    // the variant's, must outlive the rules
+};
+
+GameRules rules_for(const Variant& v);
+
+// FEN parsed with the variant's piece list, neutrals and turn length
+Bitboards setup_board(const Variant& v, const GameRules& rules, const std::string& fen);
+
+// `type` as for generate_legal(); a neutral piece's move is quiet
+void generate_moves(const Bitboards& bb, const GameRules& rules, MoveList& list, GenType type = ALL_MOVES);
+
+// True when generate_moves(bb, rules, list, QUIETS) would produce m,
+// checked without generating the list (a TT move from another position)
+bool is_quiet_move(const Bitboards& bb, const GameRules& rules, Move m);
+
+// make_move plus the variant's turn rules; undo with unmake_move()
+void play_move(Bitboards& bb, Move m, UndoInfo& undo, const Zobrist& z, const GameRules& rules);
+
+// Pseudo-moves of the side to move from the compiled programs, kings
+// included among the captures (Flock's first sub-move)
+void generate_piece_moves(const Bitboards& bb, const PiecePrograms& programs, MoveList& list,
+                          GenType type = ALL_MOVES);
+// Every neutral piece's quiet moves (Flock's second sub-move)
+void generate_neutral_moves(const Bitboards& bb, const PiecePrograms& programs, MoveList& list);
+
+// History entries between positions with the same side to move and
+// sub-move index: two full turns, or 1 where turns can end early
+int repetition_stride(const GameRules& rules);
+
+// halfmove_clock value at which the 50-move rule draws: 100 plies of
+// piece moves (Flock's duck moves do not tick the clock)
+int fifty_move_limit(const GameRules& rules);
+
+// Draw by the 50-move rule, or by the current position having occurred
+// `repeats` times before within the reversible stretch of `history`
+// (1 is what a search uses, 2 is threefold repetition)
+bool is_draw(const Bitboards& bb, const GameRules& rules, const History& history, int repeats = 1);
+
+// Pieces of both sides attacking sq through occ (neutral pieces never
+// capture, they only block). Standard rules use attackers_to() from
+// legal.h; Flock reverses each piece type's compiled program, and scans
+// forward from each piece only for programs without a reverse.
+Bitboard attackers_to(const Bitboards& bb, const GameRules& rules, int sq, Bitboard occ);
+
+// Coordinate notation, e.g. "e2e4", "e7e8Q"; a duck part as "/c4d5"
+std::string move_to_string(const Bitboards& bb, Move m);
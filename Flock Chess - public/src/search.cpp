@@ -0,0 +1,442 @@
+#include "search.h"
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+// Mate scores are stored relative to the node, not the root, so a
+// transposition reached at another ply reads back the right distance
+static int value_to_tt(int v, int ply) {
+    return v >= VALUE_MATE_IN_MAX_PLY ? v + ply : v <= -VALUE_MATE_IN_MAX_PLY ? v - ply : v;
+}
+
+static int value_from_tt(int v, int ply) {
+    return v >= VALUE_MATE_IN_MAX_PLY ? v - ply : v <= -VALUE_MATE_IN_MAX_PLY ? v + ply : v;
+}
+
+Searcher::Searcher(const GameRules& rules, const Zobrist& z, TranspositionTable& tt)
+    : rules(rules), z(z), tt(tt) {}
+
+// This thread's nodes, or the whole pool's
+uint64_t Searcher::total_nodes() {
+    publishedNodes.store(nodes, std::memory_order_relaxed);
+    return pool ? pool->node_count() : nodes;
+}
+
+bool Searcher::limits_reached() {
+    if (limits.nodes && total_nodes() >= limits.nodes)
+        return true;
+    if (!limits.movetimeMs)
+        return false;
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count() >= limits.movetimeMs;
+}
+
+// Polled every 1024 nodes. Only thread 0 checks the limits, and never
+// before its first iteration is done.
+bool Searcher::should_stop() {
+    if (aborted())
+        return true;
+    if (nodes & 1023)
+        return false;
+    publishedNodes.store(nodes, std::memory_order_relaxed);
+    if (threadId != 0 || !canStop || !limits_reached())
+        return false;
+    stop();
+    return true;
+}
+
+int Searcher::terminal_score(const Bitboards& bb, int ply) const {
+    if (rules.flock) {
+        // Only a king capture ends a Flock game early
+        bool ownKing = bb.piece_board(bb.w_to_move ? 'K' : 'k');
+        bool theirKing = bb.piece_board(bb.w_to_move ? 'k' : 'K');
+        if (!ownKing)
+            return -VALUE_MATE + ply;
+        if (!theirKing)
+            return VALUE_MATE - ply;
+        return VALUE_DRAW;
+    }
+    return king_in_check(bb, bb.w_to_move) ? -VALUE_MATE + ply : VALUE_DRAW;
+}
+
+static bool is_quiet(Move m) {
+    return !move_is_capture(m) && move_type(m) != PROMOTION;
+}
+
+// The quiet move that failed high becomes a killer of this ply and the
+// counter-move to the previous move, and gains history; the quiets
+// searched before it lose. h += b - h*|b|/MAX keeps entries within +-MAX.
+void Searcher::update_refutations(const Bitboards& bb, Move best, const Move* tried, int count,
+                                  int depth, int ply) {
+    constexpr int MAX_HISTORY = 1 << 14;
+    const int bonus = std::min(depth * depth, 400);
+    auto update = [&](Move m, int b) {
+        int& h = quietHistory[bb.mailbox[move_from(m)]][move_to(m)];
+        h += b - h * std::abs(b) / MAX_HISTORY;
+    };
+    update(best, bonus);
+    for (int i = 0; i < count; i++)
+        update(tried[i], -bonus);
+
+    if (killers[ply][0] != best) {
+        killers[ply][1] = killers[ply][0];
+        killers[ply][0] = best;
+    }
+    if (prevPiece[ply] != NO_PIECE)
+        counterMoves[prevPiece[ply]][prevTo[ply]] = best;
+}
+
+// The side to move's king is attacked; for Flock, where kings are
+// captured rather than mated, that is the analogue of check
+bool Searcher::in_check(const Bitboards& bb) const {
+    if (!rules.flock)
+        return king_in_check(bb, bb.w_to_move);
+    Bitboard king = bb.piece_board(bb.w_to_move ? 'K' : 'k');
+    Bitboard them = bb.w_to_move ? bb.b_occupancy : bb.w_occupancy;
+    return king && (attackers_to(bb, rules, indexLSB(king), bb.occupancy) & them);
+}
+
+// Captures only, standing pat on the static evaluation, until the
+// position is quiet; captures SEE says lose are not tried. In check every
+// move is searched instead, so a mate (or a Flock king capture) just past
+// the horizon is seen. Flock's duck sub-move is played with the first
+// placement found, not searched, to keep the exchange going.
+int Searcher::qsearch(Bitboards& bb, int alpha, int beta, int ply) {
+    pvLength[ply] = ply;
+    nodes++;
+
+    if (should_stop())
+        return VALUE_DRAW;
+    if (rules.flock && (!bb.piece_board('K') || !bb.piece_board('k')))
+        return terminal_score(bb, ply);
+    if (ply >= MAX_PLY)
+        return evaluate(bb, evaluator);
+
+    const bool mover = bb.w_to_move;
+    if (rules.flock && bb.sub_move != 0) {
+        MoveList list;
+        generate_moves(bb, rules, list);
+        if (list.size == 0)
+            return evaluate(bb, evaluator);
+        UndoInfo undo;
+        play_move(bb, list.moves[0], undo, z, rules);
+        int value = bb.w_to_move != mover ? -qsearch(bb, -beta, -alpha, ply + 1)
+                                          : qsearch(bb, alpha, beta, ply + 1);
+        unmake_move(bb, list.moves[0], undo);
+        return value;
+    }
+
+    TTData entry;
+    Move ttMove = NO_MOVE;
+    if (tt.probe(bb.zobrist_hash, entry)) {
+        ttMove = entry.move;
+        int ttValue = value_from_tt(entry.value, ply);
+        if (entry.bound == BOUND_EXACT
+            || (entry.bound == BOUND_LOWER && ttValue >= beta)
+            || (entry.bound == BOUND_UPPER && ttValue <= alpha))
+            return ttValue;
+    }
+
+    const bool check = in_check(bb);
+    const int alphaOrig = alpha;
+    int best = -VALUE_INFINITE;
+    if (!check) {
+        best = evaluate(bb, evaluator);
+        if (best >= beta)
+            return best;
+        alpha = std::max(alpha, best);
+    }
+
+    static constexpr Move NO_KILLERS[2] = { NO_MOVE, NO_MOVE };
+    MovePicker picker = check ? MovePicker(bb, rules, evaluator, quietHistory, ttMove, NO_KILLERS, NO_MOVE)
+                              : MovePicker(bb, rules, evaluator, ttMove);
+    Move bestMove = NO_MOVE;
+    int moveCount = 0;
+
+    for (Move m = picker.next(); m != NO_MOVE; m = picker.next()) {
+        moveCount++;
+        UndoInfo undo;
+        play_move(bb, m, undo, z, rules);
+        tt.prefetch(bb.zobrist_hash);
+        int value = bb.w_to_move != mover ? -qsearch(bb, -beta, -alpha, ply + 1)
+                                          : qsearch(bb, alpha, beta, ply + 1);
+        unmake_move(bb, m, undo);
+        if (aborted())
+            return VALUE_DRAW;
+
+        if (value > best) {
+            best = value;
+            bestMove = m;
+            if (value > alpha) {
+                alpha = value;
+                if (alpha >= beta)
+                    break;
+            }
+        }
+    }
+    if (check && moveCount == 0)
+        return terminal_score(bb, ply);
+
+    Bound bound = best >= beta ? BOUND_LOWER : best > alphaOrig ? BOUND_EXACT : BOUND_UPPER;
+    tt.store(bb.zobrist_hash, bestMove, value_to_tt(best, ply), 0, bound);
+    return best;
+}
+
+int Searcher::negamax(Bitboards& bb, int alpha, int beta, int depth, int ply) {
+    const bool pvNode = beta - alpha > 1;
+    pvLength[ply] = ply;
+
+    if (ply > 0) {
+        if (should_stop())
+            return VALUE_DRAW;
+        if (is_draw(bb, rules, history))
+            return VALUE_DRAW;
+        if (ply >= MAX_PLY)
+            return evaluate(bb, evaluator);
+    }
+
+    if (depth <= 0)
+        return qsearch(bb, alpha, beta, ply);
+    nodes++;
+
+    TTData entry;
+    Move ttMove = NO_MOVE;
+    if (tt.probe(bb.zobrist_hash, entry)) {
+        ttMove = entry.move;
+        int ttValue = value_from_tt(entry.value, ply);
+        if (!pvNode && entry.depth >= depth
+            && (entry.bound == BOUND_EXACT
+                || (entry.bound == BOUND_LOWER && ttValue >= beta)
+                || (entry.bound == BOUND_UPPER && ttValue <= alpha)))
+            return ttValue;
+    }
+
+    const Move counter = prevPiece[ply] == NO_PIECE ? NO_MOVE : counterMoves[prevPiece[ply]][prevTo[ply]];
+    MovePicker picker(bb, rules, evaluator, quietHistory, ttMove, killers[ply], counter,
+                      threadId != 0 ? &rng : nullptr);
+
+    const bool mover = bb.w_to_move;
+    const int alphaOrig = alpha;
+    int best = -VALUE_INFINITE;
+    Move bestMove = NO_MOVE;
+    int moveCount = 0;
+    Move quietsTried[MAX_MOVES];
+    int quietCount = 0;
+
+    for (Move m = picker.next(); m != NO_MOVE; m = picker.next()) {
+        moveCount++;
+        UndoInfo undo;
+        play_move(bb, m, undo, z, rules);
+        tt.prefetch(bb.zobrist_hash);
+        history.push(bb.zobrist_hash);
+        prevPiece[ply + 1] = bb.mailbox[move_to(m)];
+        prevTo[ply + 1] = static_cast<uint8_t>(move_to(m));
+
+        // Search a child window, negated only if the turn passed
+        const bool flip = bb.w_to_move != mover;
+        auto child = [&](int a, int b) {
+            return flip ? -negamax(bb, -b, -a, depth - 1, ply + 1) : negamax(bb, a, b, depth - 1, ply + 1);
+        };
+        int value;
+        if (moveCount == 1) {
+            value = child(alpha, beta);
+        } else {
+            value = child(alpha, alpha + 1);
+            if (value > alpha && value < beta)
+                value = child(alpha, beta);
+        }
+
+        history.pop();
+        unmake_move(bb, m, undo);
+        if (aborted())
+            return VALUE_DRAW;
+
+        if (value > best) {
+            best = value;
+            bestMove = m;
+            if (value > alpha) {
+                alpha = value;
+                pv[ply][ply] = m;
+                for (int j = ply + 1; j < pvLength[ply + 1]; j++)
+                    pv[ply][j] = pv[ply + 1][j];
+                pvLength[ply] = std::max(pvLength[ply + 1], ply + 1);
+                if (alpha >= beta) {
+                    if (is_quiet(m))
+                        update_refutations(bb, m, quietsTried, quietCount, depth, ply);
+                    break;
+                }
+            }
+        }
+        if (is_quiet(m))
+            quietsTried[quietCount++] = m;
+    }
+    if (moveCount == 0)
+        return terminal_score(bb, ply);
+
+    Bound bound = best >= beta ? BOUND_LOWER : best > alphaOrig ? BOUND_EXACT : BOUND_UPPER;
+    tt.store(bb.zobrist_hash, bestMove, value_to_tt(best, ply), depth, bound);
+    return best;
+}
+
+// Narrow window around the last iteration's score, widened on the
+// failing side until the score falls inside it
+int Searcher::aspiration(Bitboards& bb, int depth, int previous) {
+    int delta = 25;
+    int alpha = -VALUE_INFINITE, beta = VALUE_INFINITE;
+    if (depth >= 4 && std::abs(previous) < VALUE_MATE_IN_MAX_PLY) {
+        alpha = std::max(previous - delta, -VALUE_INFINITE);
+        beta = std::min(previous + delta, VALUE_INFINITE);
+    }
+    while (true) {
+        int value = negamax(bb, alpha, beta, depth, 0);
+        if (aborted())
+            return value;
+        if (value <= alpha)
+            alpha = std::max(value - delta, -VALUE_INFINITE);
+        else if (value >= beta)
+            beta = std::min(value + delta, VALUE_INFINITE);
+        else
+            return value;
+        delta *= 2;
+    }
+}
+
+void Searcher::prepare(const Bitboards& root, const History& gameHistory, const SearchLimits& searchLimits) {
+    limits = searchLimits;
+    start = std::chrono::steady_clock::now();
+    canStop = false;
+    nodes = 0;
+    publishedNodes.store(0, std::memory_order_relaxed);
+    rng = 0x9E3779B97F4A7C15ULL * static_cast<uint64_t>(threadId + 1);
+    std::fill(&killers[0][0], &killers[0][0] + 2 * (MAX_PLY + 1), NO_MOVE);
+    prevPiece[0] = NO_PIECE;
+    evaluator = make_evaluator(root, rules);
+    history = gameHistory;
+    if (history.size() == 0 || history.keys.back() != root.zobrist_hash)
+        history.push(root.zobrist_hash);
+}
+
+// Helper depth skipping: helper i skips the depths where
+// (depth + SKIP_PHASE) / SKIP_SIZE is odd, so at any time the helpers are
+// spread over the next few depths instead of all searching thread 0's
+static constexpr int SKIP_SIZE[] = { 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 4, 4, 4, 4, 4, 4, 4, 4 };
+static constexpr int SKIP_PHASE[] = { 0, 1, 0, 1, 2, 3, 0, 1, 2, 3, 4, 5, 0, 1, 2, 3, 4, 5, 6, 7 };
+
+bool Searcher::skip_depth(int depth) const {
+    if (threadId == 0 || depth == 1)
+        return false;
+    int i = (threadId - 1) % 20;
+    return ((depth + SKIP_PHASE[i]) / SKIP_SIZE[i]) % 2;
+}
+
+SearchResult Searcher::iterate(const Bitboards& root, const InfoCallback& onIteration) {
+    SearchResult result;
+    Bitboards bb = root;
+    int score = 0;
+    for (int depth = 1; depth <= std::min(limits.depth, MAX_PLY - 1); depth++) {
+        if (skip_depth(depth))
+            continue;
+        int value = aspiration(bb, depth, score);
+        if (aborted())
+            break;
+        score = value;
+        canStop = true;
+
+        result.info.depth = depth;
+        result.info.score = score;
+        result.info.nodes = total_nodes();
+        result.info.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        result.info.pv.assign(pv[0], pv[0] + pvLength[0]);
+        result.best = pvLength[0] ? pv[0][0] : NO_MOVE;
+        if (onIteration)
+            onIteration(result.info);
+
+        if (result.best == NO_MOVE || (threadId == 0 && limits_reached()))
+            break;
+    }
+    publishedNodes.store(nodes, std::memory_order_relaxed);
+
+    // Stopped from outside before the first iteration finished
+    if (result.best == NO_MOVE && result.info.depth == 0) {
+        MoveList list;
+        generate_moves(root, rules, list);
+        if (list.size)
+            result.best = list.moves[0];
+    }
+    return result;
+}
+
+SearchResult Searcher::search(const Bitboards& root, const History& gameHistory, const SearchLimits& searchLimits,
+                              const InfoCallback& onIteration) {
+    tt.new_search();
+    prepare(root, gameHistory, searchLimits);
+    SearchResult result = iterate(root, onIteration);
+    // Cleared on the way out, not in, so a stop() that lands before the
+    // search starts is not lost
+    stopFlag->store(false, std::memory_order_relaxed);
+    return result;
+}
+
+// ======================================================
+// SearchPool
+// ======================================================
+
+SearchPool::SearchPool(const GameRules& rules, const Zobrist& z, TranspositionTable& tt, int threads)
+    : rules(rules), z(z), tt(tt) {
+    set_threads(threads);
+}
+
+void SearchPool::set_threads(int threads) {
+    searchers.clear();
+    for (int i = 0; i < std::max(1, threads); i++) {
+        searchers.push_back(std::make_unique<Searcher>(rules, z, tt));
+        Searcher& s = *searchers.back();
+        s.threadId = i;
+        s.pool = this;
+        s.stopFlag = &stopFlag;
+    }
+}
+
+uint64_t SearchPool::node_count() const {
+    uint64_t total = 0;
+    for (const auto& s : searchers)
+        total += s->publishedNodes.load(std::memory_order_relaxed);
+    return total;
+}
+
+SearchResult SearchPool::search(const Bitboards& root, const History& gameHistory, const SearchLimits& limits,
+                                const InfoCallback& onIteration) {
+    tt.new_search();
+    for (auto& s : searchers)
+        s->prepare(root, gameHistory, limits);
+
+    std::vector<SearchResult> results(searchers.size());
+    std::vector<std::thread> helpers;
+    for (size_t i = 1; i < searchers.size(); i++)
+        helpers.emplace_back([&, i]() { results[i] = searchers[i]->iterate(root, nullptr); });
+    results[0] = searchers[0]->iterate(root, onIteration);
+
+    // Thread 0 is done (limit reached or depth finished): stop the helpers
+    stop();
+    for (std::thread& t : helpers)
+        t.join();
+    stopFlag.store(false, std::memory_order_relaxed);      // as in Searcher::search
+
+    SearchResult best = results[0];
+    for (size_t i = 1; i < results.size(); i++) {
+        const SearchResult& r = results[i];
+        if (r.best != NO_MOVE && r.info.depth > best.info.depth && r.info.score >= best.info.score)
+            best = r;
+    }
+    best.info.nodes = node_count();
+    return best;
+}
+
+std::string score_to_string(int score) {
+    if (score >= VALUE_MATE_IN_MAX_PLY)
+        return "mate " + std::to_string(VALUE_MATE - score);
+    if (score <= -VALUE_MATE_IN_MAX_PLY)
+        return "mate -" + std::to_string(VALUE_MATE + score);
+    return "cp " + std::to_string(score);
+}
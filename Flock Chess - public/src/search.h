@@ -0,0 +1,168 @@
+// search.h
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "movepick.h"
+#include "tt.h"
+
+// =====================================================
+// Alpha-beta search
+// =====================================================
+/*
+  Negamax with principal variation search, iterative deepening and
+  aspiration windows, over the moves of generate_moves(), so the same code
+  plays standard chess, Marseillais (Move_num = 2) and Flock.
+
+  One ply of depth is one sub-move. The side to move does not always
+  change after a move (the first half of a Marseillais or Flock turn), so
+  a child's score is negated only when it does; scores are always from the
+  point of view of the side to move at the node.
+
+  Terminal nodes: a Flock game is over once a king has been captured; in
+  the other variants no legal moves is mate or stalemate. Mate scores
+  count sub-moves from the root (VALUE_MATE - ply). Past depth 0 a
+  quiescence search plays out the captures (see.h prunes the losing ones).
+*/
+constexpr int MAX_PLY = 128;
+constexpr int VALUE_DRAW = 0;
+constexpr int VALUE_MATE = 32000;
+constexpr int VALUE_INFINITE = 32001;
+constexpr int VALUE_MATE_IN_MAX_PLY = VALUE_MATE - MAX_PLY;
+
+struct SearchLimits {
+    int depth = MAX_PLY - 1;
+    uint64_t nodes = 0;             // 0: no limit
+    int64_t movetimeMs = 0;         // 0: no limit
+};
+
+// One completed iteration
+struct SearchInfo {
+    int depth = 0;
+    int score = 0;
+    uint64_t nodes = 0;
+    double seconds = 0.0;
+    std::vector<Move> pv;
+};
+
+using InfoCallback = std::function<void(const SearchInfo&)>;
+
+struct SearchResult {
+    Move best = NO_MOVE;
+    SearchInfo info;                // the last completed iteration
+};
+
+class SearchPool;
+
+// One search thread: its own board copy, repetition history, PV and
+// move-ordering tables, sharing only the transposition table
+class Searcher {
+public:
+    // rules, z and tt must outlive the searcher
+    Searcher(const GameRules& rules, const Zobrist& z, TranspositionTable& tt);
+
+    // Single-threaded search. `history` holds the game so far, the root
+    // position last (it may be empty). Node and time limits never cut the
+    // first iteration short, so a best move is returned whenever the root
+    // has one.
+    SearchResult search(const Bitboards& root, const History& history, const SearchLimits& limits,
+                        const InfoCallback& onIteration = nullptr);
+
+    // Thread-safe: the running search returns at its next check. A stop
+    // made between searches ends the next one at once.
+    void stop() { stopFlag->store(true, std::memory_order_relaxed); }
+
+    // Nodes of this thread's last search
+    uint64_t node_count() const { return nodes; }
+
+private:
+    friend class SearchPool;
+
+    void prepare(const Bitboards& root, const History& history, const SearchLimits& limits);
+    SearchResult iterate(const Bitboards& root, const InfoCallback& onIteration);
+    bool skip_depth(int depth) const;
+
+    int negamax(Bitboards& bb, int alpha, int beta, int depth, int ply);
+    int qsearch(Bitboards& bb, int alpha, int beta, int ply);
+    bool in_check(const Bitboards& bb) const;
+    int aspiration(Bitboards& bb, int depth, int previous);
+    int terminal_score(const Bitboards& bb, int ply) const;
+    void update_refutations(const Bitboards& bb, Move best, const Move* tried, int count, int depth, int ply);
+    uint64_t total_nodes();
+    bool limits_reached();
+    bool should_stop();
+    bool aborted() const { return stopFlag->load(std::memory_order_relaxed); }
+
+    const GameRules& rules;
+    const Zobrist& z;
+    TranspositionTable& tt;
+
+    // Set by SearchPool: thread 0 checks the limits and reports, the
+    // helpers only watch the shared stop flag
+    int threadId = 0;
+    const SearchPool* pool = nullptr;
+    std::atomic<bool> ownStop{ false };
+    std::atomic<bool>* stopFlag = &ownStop;
+    std::atomic<uint64_t> publishedNodes{ 0 };  // nodes, updated every 1024
+
+    Evaluator evaluator;
+    History history;
+    SearchLimits limits;
+    std::chrono::steady_clock::time_point start;
+    bool canStop = false;           // false until the first iteration is done
+    uint64_t nodes = 0;
+    uint64_t rng = 0;               // helpers' move-order jitter
+
+    // Move ordering (movepick.h). History and counter-moves are kept
+    // between searches; history is bounded by its update rule.
+    PieceToTable<int> quietHistory{};
+    PieceToTable<Move> counterMoves{};
+    Move killers[MAX_PLY + 1][2] = {};
+    uint8_t prevPiece[MAX_PLY + 2] = {};    // piece ID and square of the move into each ply
+    uint8_t prevTo[MAX_PLY + 2] = {};
+
+    Move pv[MAX_PLY + 1][MAX_PLY + 1] = {};
+    int pvLength[MAX_PLY + 1] = {};
+};
+
+// =====================================================
+// Lazy SMP
+// =====================================================
+/*
+  N searchers run the same root at once and share only the transposition
+  table: what one thread stores, the others find as TT moves and cutoffs.
+  To keep the threads apart, helpers skip some iteration depths (each on
+  its own phase) and jitter the order of quiet moves. Thread 0 checks the
+  limits and reports; when it stops, the shared flag stops the helpers.
+  The answer is thread 0's unless a helper completed a deeper iteration
+  with a score at least as good.
+*/
+class SearchPool {
+public:
+    SearchPool(const GameRules& rules, const Zobrist& z, TranspositionTable& tt, int threads = 1);
+
+    void set_threads(int threads);
+    int thread_count() const { return static_cast<int>(searchers.size()); }
+
+    // As Searcher::search; onIteration is called from thread 0 only
+    SearchResult search(const Bitboards& root, const History& history, const SearchLimits& limits,
+                        const InfoCallback& onIteration = nullptr);
+
+    // Thread-safe, as Searcher::stop
+    void stop() { stopFlag.store(true, std::memory_order_relaxed); }
+
+    // Nodes of all threads, current to within 1024 per thread
+    uint64_t node_count() const;
+
+private:
+    const GameRules& rules;
+    const Zobrist& z;
+    TranspositionTable& tt;
+    std::atomic<bool> stopFlag{ false };
+    std::vector<std::unique_ptr<Searcher>> searchers;
+};
+
+// "cp 25", or "mate 3" / "mate -2" in sub-moves
+std::string score_to_string(int score);
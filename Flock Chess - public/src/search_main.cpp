@@ -0,0 +1,80 @@
+// search: best move for a variant and FEN
+//
+// Usage: search <variant> "<fen>|startpos" [depth N] [nodes N] [movetime MS] [hash MB] [threads N] [ini variants.ini]
+//
+// Prints one info line per completed iteration, then "bestmove". Mate
+// scores count sub-moves, not turns.
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include "search.h"
+
+int main(int argc, char* argv[]) {
+    if (argc < 3 || (argc - 3) % 2) {
+        std::fprintf(stderr, "Usage: search <variant> \"<fen>|startpos\" [depth N] [nodes N] [movetime MS] [hash MB] [threads N] [ini variants.ini]\n");
+        return 1;
+    }
+    std::string gameMode = argv[1];
+    std::string fen = argv[2];
+    SearchLimits limits;
+    size_t hashMb = 64;
+    int threads = 1;
+    std::string ini = "../variants.ini";
+    bool bounded = false;
+
+    for (int i = 3; i + 1 < argc; i += 2) {
+        std::string key = argv[i];
+        const char* value = argv[i + 1];
+        if (key == "depth")         limits.depth = std::atoi(value), bounded = true;
+        else if (key == "nodes")    limits.nodes = std::strtoull(value, nullptr, 10), bounded = true;
+        else if (key == "movetime") limits.movetimeMs = std::atoll(value), bounded = true;
+        else if (key == "hash")     hashMb = std::strtoul(value, nullptr, 10);
+        else if (key == "threads")  threads = std::max(1, std::atoi(value));
+        else if (key == "ini")      ini = value;
+        else {
+            std::fprintf(stderr, "Error: unknown option '%s'\n", key.c_str());
+            return 1;
+        }
+    }
+    if (!bounded)
+        limits.depth = 6;
+
+    auto variants = parse(ini);
+    auto it = variants.find(gameMode);
+    if (it == variants.end()) {
+        std::fprintf(stderr, "Error: Variant '%s' not found in %s\n", gameMode.c_str(), ini.c_str());
+        return 1;
+    }
+    const Variant& v = it->second;
+    if (fen == "startpos")
+        fen = v.stdPos;
+
+    init_attack_tables();
+    GameRules rules = rules_for(v);
+    Zobrist z;
+    init_zobrist(z, v.pieces, 0);
+    Bitboards bb = setup_board(v, rules, fen);
+    bb.zobrist_hash = compute_zobrist(bb, z);
+
+    TranspositionTable tt(hashMb);
+    SearchPool pool(rules, z, tt, threads);
+    SearchResult result = pool.search(bb, History(), limits, [&](const SearchInfo& info) {
+        std::string pv;
+        Bitboards line = bb;
+        for (Move m : info.pv) {
+            pv += " " + move_to_string(line, m);
+            UndoInfo undo;
+            play_move(line, m, undo, z, rules);
+        }
+        std::printf("info depth %d score %s nodes %llu time %.0f nps %.0f hashfull %d pv%s\n",
+                    info.depth, score_to_string(info.score).c_str(), (unsigned long long)info.nodes,
+                    info.seconds * 1000, info.seconds > 0 ? info.nodes / info.seconds : 0.0,
+                    tt.hashfull(), pv.c_str());
+        std::fflush(stdout);
+    });
+
+    std::printf("bestmove %s\n", result.best == NO_MOVE ? "(none)" : move_to_string(bb, result.best).c_str());
+    return 0;
+}
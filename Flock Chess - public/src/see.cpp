@@ -0,0 +1,59 @@
+#include "see.h"
+#include <algorithm>
+
+static int see_value(const Evaluator& ev, uint8_t id) {
+    return ev.king[id] ? SEE_KING_VALUE : ev.value[id];
+}
+
+int see(const Bitboards& bb, const GameRules& rules, const Evaluator& ev, Move m) {
+    const int from = move_from(m), to = move_to(m);
+    const uint8_t mover = bb.mailbox[from];
+
+    int gain[32];
+    int d = 0;
+    Bitboard occ = bb.occupancy ^ (1ULL << from);
+    int onSquare = see_value(ev, mover);      // value of the piece that would be taken next
+
+    if (move_type(m) == EN_PASSANT) {
+        int capSq = to + (to > from ? -8 : 8);
+        occ ^= 1ULL << capSq;
+        gain[0] = see_value(ev, bb.mailbox[capSq]);
+    } else {
+        uint8_t victim = bb.mailbox[to];
+        gain[0] = victim == NO_PIECE ? 0 : see_value(ev, victim);
+    }
+    if (move_type(m) == PROMOTION) {
+        gain[0] += ev.value[move_promo(m)] - onSquare;
+        onSquare = ev.value[move_promo(m)];
+    }
+
+    bool white = !((bb.w_occupancy >> from) & 1);     // side to recapture
+    Bitboard attackers = attackers_to(bb, rules, to, occ) & occ;
+    while (d < 31) {
+        Bitboard ours = attackers & (white ? bb.w_occupancy : bb.b_occupancy);
+        if (!ours)
+            break;
+
+        // Least valuable attacker
+        int sq = -1, value = 0;
+        for (Bitboard b = ours; b; b &= b - 1) {
+            int s = indexLSB(b);
+            int v = see_value(ev, bb.mailbox[s]);
+            if (sq < 0 || v < value)
+                sq = s, value = v;
+        }
+
+        // gain[d]: the capturer's balance if the exchange ends here
+        d++;
+        gain[d] = onSquare - gain[d - 1];
+
+        onSquare = value;
+        occ ^= 1ULL << sq;
+        attackers = attackers_to(bb, rules, to, occ) & occ;   // x-rays
+        white = !white;
+    }
+    // Each capturer may also decline, keeping the previous balance
+    for (; d > 0; d--)
+        gain[d - 1] = -std::max(-gain[d - 1], gain[d]);
+    return gain[0];
+}
@@ -0,0 +1,21 @@
+// see.h
+#pragma once
+#include "eval.h"
+
+// =====================================================
+// Static exchange evaluation
+// =====================================================
+/*
+  Material result, for the side making move m, of the capture sequence on
+  its target square when both sides recapture with their least valuable
+  attacker and either may stop. Attackers come from attackers_to() with
+  the pieces already used taken out of the occupancy, so sliders (and
+  fairy riders) lined up behind them join in: the x-rays. Values are the
+  Evaluator's, a king 20000, so a king only recaptures last.
+
+  Sides are taken to alternate, which is exact for Flock (the duck's
+  sub-move cannot capture) and an estimate for Marseillais.
+*/
+constexpr int SEE_KING_VALUE = 20000;
+
+int see(const Bitboards& bb, const GameRules& rules, const Evaluator& ev, Move m);
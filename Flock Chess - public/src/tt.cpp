@@ -0,0 +1,137 @@
+#include "tt.h"
+#include <cstdlib>
+#include <climits>
+#include <cstring>
+#include <new>
+
+#ifdef __linux__
+    #include <sys/mman.h>
+#endif
+#ifdef _MSC_VER
+    #include <malloc.h>
+#endif
+
+namespace {
+
+constexpr size_t HUGE_PAGE = 2 * 1024 * 1024;
+
+void* allocate(size_t size) {
+#ifdef _MSC_VER
+    return _aligned_malloc(size, 64);
+#else
+    size_t align = size >= HUGE_PAGE ? HUGE_PAGE : 64;
+    void* mem = std::aligned_alloc(align, (size + align - 1) / align * align);
+    #ifdef __linux__
+    if (mem && align == HUGE_PAGE)
+        madvise(mem, size, MADV_HUGEPAGE);
+    #endif
+    return mem;
+#endif
+}
+
+void release(void* mem) {
+#ifdef _MSC_VER
+    _aligned_free(mem);
+#else
+    std::free(mem);
+#endif
+}
+
+uint64_t pack(Move move, int value, int depth, Bound bound, uint8_t generation) {
+    return static_cast<uint64_t>(move)
+         | static_cast<uint64_t>(static_cast<uint16_t>(value)) << 32
+         | static_cast<uint64_t>(static_cast<uint8_t>(depth)) << 48
+         | static_cast<uint64_t>(bound) << 56
+         | static_cast<uint64_t>(generation) << 58;
+}
+
+int depth_of(uint64_t data) { return static_cast<int8_t>(data >> 48); }
+Bound bound_of(uint64_t data) { return static_cast<Bound>((data >> 56) & 3); }
+uint8_t generation_of(uint64_t data) { return static_cast<uint8_t>(data >> 58); }
+
+} // namespace
+
+TranspositionTable::~TranspositionTable() {
+    release(table);
+}
+
+void TranspositionTable::resize(size_t megabytes) {
+    release(table);
+    table = nullptr;
+
+    size_t clusters = 1;
+    while (clusters * 2 * sizeof(Cluster) <= megabytes * 1024 * 1024)
+        clusters *= 2;
+    bytes = clusters * sizeof(Cluster);
+    table = static_cast<Cluster*>(allocate(bytes));
+    if (!table)
+        throw std::bad_alloc();
+    clusterMask = clusters - 1;
+    clear();
+}
+
+void TranspositionTable::clear() {
+    std::memset(static_cast<void*>(table), 0, bytes);
+    generation = 0;
+}
+
+bool TranspositionTable::probe(uint64_t key, TTData& out) const {
+    const Cluster* c = cluster_for(key);
+    for (const Entry& e : c->entries) {
+        uint64_t data = e.data.load(std::memory_order_relaxed);
+        if ((e.check.load(std::memory_order_relaxed) ^ data) != key || bound_of(data) == BOUND_NONE)
+            continue;
+        out.move = static_cast<Move>(data);
+        out.value = static_cast<int16_t>(data >> 32);
+        out.depth = static_cast<int8_t>(depth_of(data));
+        out.bound = bound_of(data);
+        return true;
+    }
+    return false;
+}
+
+void TranspositionTable::store(uint64_t key, Move move, int value, int depth, Bound bound) {
+    Cluster* c = cluster_for(key);
+    Entry* victim = &c->entries[0];
+    int victimWorth = INT32_MAX;
+
+    for (Entry& e : c->entries) {
+        uint64_t data = e.data.load(std::memory_order_relaxed);
+        if ((e.check.load(std::memory_order_relaxed) ^ data) == key) {
+            // Same position: keep the old best move if the new result has none
+            if (move == NO_MOVE)
+                move = static_cast<Move>(data);
+            victim = &e;
+            break;
+        }
+        int age = (generation - generation_of(data)) & GENERATION_MASK;
+        int worth = bound_of(data) == BOUND_NONE ? INT32_MIN : depth_of(data) - 8 * age;
+        if (worth < victimWorth) {
+            victimWorth = worth;
+            victim = &e;
+        }
+    }
+
+    uint64_t data = pack(move, value, depth, bound, generation);
+    victim->check.store(key ^ data, std::memory_order_relaxed);
+    victim->data.store(data, std::memory_order_relaxed);
+}
+
+void TranspositionTable::prefetch(uint64_t key) const {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(cluster_for(key));
+#else
+    (void)key;
+#endif
+}
+
+int TranspositionTable::hashfull() const {
+    int used = 0;
+    size_t sample = clusterMask + 1 < 250 ? clusterMask + 1 : 250;
+    for (size_t i = 0; i < sample; i++)
+        for (const Entry& e : table[i].entries) {
+            uint64_t data = e.data.load(std::memory_order_relaxed);
+            used += bound_of(data) != BOUND_NONE && generation_of(data) == generation;
+        }
+    return static_cast<int>(used * 1000 / (sample * ENTRIES_PER_CLUSTER));
+}
@@ -0,0 +1,82 @@
+// tt.h
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "move.h"
+
+// =====================================================
+// Transposition table
+// =====================================================
+/*
+  Fixed-size table of search results keyed by the Zobrist hash. Entries
+  come in 64-byte clusters of four, one cache line, and a key always maps
+  to one cluster, so a probe touches a single line.
+
+  Entries are shared by all search threads without locks. An entry is two
+  64-bit words, the packed data and key ^ data; a reader recomputes the key
+  from both, so an entry torn by two racing writers simply misses.
+
+  Replacement inside a cluster: the entry with the same key, else the
+  least valuable one, where value is depth minus 8 per search generation
+  of age. new_search() starts a generation.
+
+  On Linux the table is 2 MB aligned and marked MADV_HUGEPAGE, so the
+  random probes of a large table miss the TLB far less often.
+*/
+enum Bound : uint8_t { BOUND_NONE = 0, BOUND_UPPER = 1, BOUND_LOWER = 2, BOUND_EXACT = 3 };
+
+struct TTData {
+    Move move;
+    int16_t value;
+    int8_t depth;
+    Bound bound;
+};
+
+class TranspositionTable {
+public:
+    TranspositionTable() = default;
+    explicit TranspositionTable(size_t megabytes) { resize(megabytes); }
+    ~TranspositionTable();
+
+    TranspositionTable(const TranspositionTable&) = delete;
+    TranspositionTable& operator=(const TranspositionTable&) = delete;
+
+    // Drops all entries; the size is rounded down to a power of two clusters
+    void resize(size_t megabytes);
+    void clear();
+    void new_search() { generation = (generation + 1) & GENERATION_MASK; }
+
+    bool probe(uint64_t key, TTData& out) const;
+    void store(uint64_t key, Move move, int value, int depth, Bound bound);
+
+    // Prefetch the key's cluster ahead of a probe (e.g. right after make_move)
+    void prefetch(uint64_t key) const;
+
+    // Permille of sampled entries written in the current generation
+    int hashfull() const;
+    size_t cluster_count() const { return clusterMask + 1; }
+
+    static constexpr int ENTRIES_PER_CLUSTER = 4;
+
+private:
+    static constexpr uint8_t GENERATION_MASK = 0x3F;
+
+    // data bits: 0-31 move, 32-47 value, 48-55 depth, 56-57 bound,
+    // 58-63 generation
+    struct Entry {
+        std::atomic<uint64_t> check;     // key ^ data
+        std::atomic<uint64_t> data;
+    };
+    struct alignas(64) Cluster {
+        Entry entries[ENTRIES_PER_CLUSTER];
+    };
+    static_assert(sizeof(Cluster) == 64, "one cluster per cache line");
+
+    Cluster* cluster_for(uint64_t key) const { return &table[key & clusterMask]; }
+
+    Cluster* table = nullptr;
+    size_t clusterMask = 0;
+    size_t bytes = 0;
+    uint8_t generation = 0;
+};
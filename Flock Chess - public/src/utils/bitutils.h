@@ -7,6 +7,10 @@ using Bitboard = uint64_t;
     #include <intrin.h>
 #endif
 
+#ifdef USE_PEXT
+    #include <immintrin.h>
+#endif
+
 // -------- Popcount --------
 inline int popcount(Bitboard b) {
 #ifdef _MSC_VER
@@ -27,6 +31,17 @@ inline int indexLSB(Bitboard b) {
 #endif
 }
 
+// -------- Most significant bit index --------
+inline int indexMSB(Bitboard b) {
+#ifdef _MSC_VER
+    unsigned long idx;
+    _BitScanReverse64(&idx, b);
+    return static_cast<int>(idx);
+#else
+    return 63 - __builtin_clzll(b);
+#endif
+}
+
 inline int lsb(uint64_t x) {
 #ifdef _MSC_VER
     unsigned long idx;
@@ -35,4 +50,23 @@ inline int lsb(uint64_t x) {
 #else
     return __builtin_ctzll(x);
 #endif
-}
\ No newline at end of file
+}
+
+// -------- Parallel bit extract --------
+// Gathers the bits of b selected by mask into the low bits of the result.
+// The software loop is what magic_gen uses, so the tables it writes do not
+// depend on the build host having BMI2.
+inline Bitboard pext_soft(Bitboard b, Bitboard mask) {
+    Bitboard result = 0;
+    for (Bitboard bit = 1; mask; bit <<= 1, mask &= mask - 1) {
+        if (b & (1ULL << indexLSB(mask)))
+            result |= bit;
+    }
+    return result;
+}
+
+#ifdef USE_PEXT
+inline Bitboard pext(Bitboard b, Bitboard mask) {
+    return _pext_u64(b, mask);
+}
+#endif
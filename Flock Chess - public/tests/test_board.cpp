@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+#include "movegen.h"
+
+static const char* FLOCK_START = "rnbqkbnr/pppppppp/8/1D1D1D/2D1D1/8/PPPPPPPP/RNBQKBNR w KQkq - 0-1";
+
+TEST(BoardTest, PieceIdsFollowTheVariantList) {
+    std::vector<char> pieces = { 'K', 'Q', 'R', 'B', 'N', 'P', 'k', 'q', 'r', 'b', 'n', 'p', 'D' };
+    Bitboards bb = parse_fen_bitboards(FLOCK_START, pieces);
+
+    ASSERT_EQ(bb.numPieces, 13);
+    for (size_t i = 0; i < pieces.size(); i++)
+        EXPECT_EQ(bb.piece_id(pieces[i]), (int)i);
+    EXPECT_EQ(bb.piece_id('x'), -1);
+
+    EXPECT_EQ(bb.piece_board('P'), 0x000000000000FF00ULL);
+    EXPECT_EQ(bb.piece_board('k'), 1ULL << 60);
+    EXPECT_EQ(bb.piece_board('x'), 0ULL);
+}
+
+TEST(BoardTest, MailboxAgreesWithPieceBoards) {
+    Bitboards bb = parse_fen_bitboards(FLOCK_START);
+    EXPECT_EQ(sizeof(bb.mailbox), 64u);
+
+    Bitboard seen = 0ULL;
+    for (int sq = 0; sq < 64; sq++) {
+        char piece = bb.piece_on(sq);
+        if (!piece) {
+            EXPECT_EQ(bb.mailbox[sq], NO_PIECE);
+            continue;
+        }
+        EXPECT_TRUE(bb.piece_board(piece) & (1ULL << sq)) << "sq " << sq;
+        seen |= 1ULL << sq;
+    }
+    EXPECT_EQ(seen, bb.occupancy);
+    EXPECT_EQ(bb.piece_on(4), 'K');
+    EXPECT_EQ(bb.piece_on(0), 'R');
+
+    // Letter-keyed adapter
+    auto boards = bb.pieceBoards();
+    EXPECT_EQ(boards.size(), (size_t)bb.numPieces);
+    EXPECT_EQ(boards.at('N'), (1ULL << 1) | (1ULL << 6));
+}
+
+TEST(BoardTest, TooManyPieceTypesThrow) {
+    Bitboards bb;
+    for (int i = 0; i < MAX_PIECES; i++)
+        bb.add_piece_type((char)('a' + i));
+    EXPECT_THROW(bb.add_piece_type('Z'), std::runtime_error);
+    EXPECT_EQ(bb.add_piece_type('a'), 0);
+}
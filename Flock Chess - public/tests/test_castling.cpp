@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include "legal.h"
+#include "castling.h"
+
+static const std::vector<char> PIECES = { 'K', 'Q', 'R', 'B', 'N', 'P', 'k', 'q', 'r', 'b', 'n', 'p', 'D' };
+
+static int sq(const char* name) { return (name[1] - '1') * 8 + (name[0] - 'a'); }
+static Bitboard bits(std::initializer_list<const char*> names) {
+    Bitboard b = 0ULL;
+    for (const char* n : names) b |= 1ULL << sq(n);
+    return b;
+}
+
+static bool has_move(const MoveList& list, Move m) {
+    return std::find(list.begin(), list.end(), m) != list.end();
+}
+
+class CastlingTest : public ::testing::Test {
+protected:
+    Zobrist z;
+    PiecePrograms programs{};
+
+    void SetUp() override {
+        init_attack_tables();
+        init_zobrist(z, PIECES, 0);
+        const char* movesets[] = { "16", "1+2", "1", "2", "3", "17", "16", "1+2", "1", "2", "3", "20", "19" };
+        for (size_t i = 0; i < PIECES.size(); i++)
+            programs[(unsigned char)PIECES[i]] = compile_moveset(movesets[i]);
+    }
+
+    Bitboards board(const std::string& fen) {
+        Bitboards bb = parse_fen_bitboards(fen, PIECES, { 'D' });
+        bb.zobrist_hash = compute_zobrist(bb, z);
+        return bb;
+    }
+};
+
+TEST_F(CastlingTest, PathMasks) {
+    const CastlingPath& wk = castlingPaths[0];
+    EXPECT_EQ(wk.right, W_KINGSIDE);
+    EXPECT_EQ(wk.empty, bits({ "f1", "g1" }));
+    EXPECT_EQ(wk.safe, bits({ "f1", "g1" }));
+
+    const CastlingPath& bq = castlingPaths[3];
+    EXPECT_EQ(bq.right, B_QUEENSIDE);
+    EXPECT_EQ(bq.kingTo, sq("c8"));
+    EXPECT_EQ(bq.rookTo, sq("d8"));
+    EXPECT_EQ(bq.empty, bits({ "b8", "c8", "d8" }));
+    EXPECT_EQ(bq.safe, bits({ "c8", "d8" }));
+
+    EXPECT_EQ(castlingMasks[sq("e1")], B_KINGSIDE | B_QUEENSIDE);
+    EXPECT_EQ(castlingMasks[sq("h8")], W_KINGSIDE | W_QUEENSIDE | B_QUEENSIDE);
+}
+
+TEST_F(CastlingTest, NeutralPiecesBlockThePath) {
+    Move oo = make_move_code(sq("e1"), sq("g1"), CASTLE_KING);
+    Move ooo = make_move_code(sq("e1"), sq("c1"), CASTLE_QUEEN);
+    MoveList list;
+    MoveTargets t;
+
+    Bitboards open = board("4k3/8/8/8/8/8/8/R3K2R w KQ - 0 1");
+    generate_legal(open, list);
+    EXPECT_TRUE(has_move(list, oo));
+    EXPECT_TRUE(has_move(list, ooo));
+    movegen(open, programs, t);
+    EXPECT_EQ(t.quiet[sq("e1")] & bits({ "g1", "c1" }), bits({ "g1", "c1" }));
+
+    // A duck on b1 is not attacked-square business, it just blocks
+    Bitboards ducked = board("4k3/8/8/8/8/8/8/RD2K1DR w KQ - 0 1");
+    generate_legal(ducked, list);
+    EXPECT_FALSE(has_move(list, oo));
+    EXPECT_FALSE(has_move(list, ooo));
+    movegen(ducked, programs, t);
+    EXPECT_EQ(t.quiet[sq("e1")] & bits({ "g1", "c1" }), 0ULL);
+}
+
+TEST_F(CastlingTest, AttackedPathOnlyStopsLegalCastling) {
+    // The rook on f8 eyes f1: no legal O-O, but b1 being attacked does not
+    // stop O-O-O
+    Bitboards bb = board("1r2kr2/8/8/8/8/8/8/R3K2R w KQ - 0 1");
+    MoveList list;
+    generate_legal(bb, list);
+    EXPECT_FALSE(has_move(list, make_move_code(sq("e1"), sq("g1"), CASTLE_KING)));
+    EXPECT_TRUE(has_move(list, make_move_code(sq("e1"), sq("c1"), CASTLE_QUEEN)));
+
+    MoveTargets t;
+    movegen(bb, programs, t);
+    EXPECT_TRUE(t.quiet[sq("e1")] & bits({ "g1" }));
+}
+
+TEST_F(CastlingTest, RightsFollowSubMoves) {
+    // Two sub-moves per turn: castle, then move again before Black
+    Bitboards bb = board("r3k2r/8/8/8/8/8/8/R3K2R w KQkq - 0 1");
+    bb.moves_per_turn = 2;
+    Bitboards before = bb;
+
+    Move oo = make_move_code(sq("e1"), sq("g1"), CASTLE_KING);
+    Move rook = make_move_code(sq("a1"), sq("a5"));
+    UndoInfo u1, u2;
+    make_move(bb, oo, u1, z);
+    EXPECT_TRUE(bb.w_to_move);
+    EXPECT_EQ(castling_bits(bb), B_KINGSIDE | B_QUEENSIDE);
+    EXPECT_EQ(bb.piece_on(sq("f1")), 'R');
+    EXPECT_EQ(bb.zobrist_hash, compute_zobrist(bb, z));
+
+    MoveList list;
+    generate_legal(bb, list);
+    EXPECT_FALSE(has_move(list, make_move_code(sq("g1"), sq("e1"), CASTLE_QUEEN)));
+    ASSERT_TRUE(has_move(list, rook));
+
+    make_move(bb, rook, u2, z);
+    EXPECT_FALSE(bb.w_to_move);
+    EXPECT_EQ(bb.zobrist_hash, compute_zobrist(bb, z));
+
+    unmake_move(bb, rook, u2);
+    unmake_move(bb, oo, u1);
+    EXPECT_EQ(castling_bits(bb), castling_bits(before));
+    EXPECT_EQ(bb.mailbox, before.mailbox);
+    EXPECT_EQ(bb.zobrist_hash, before.zobrist_hash);
+}
@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "attacks.h"
+
+class FairyTest : public ::testing::Test {
+protected:
+    static void SetUpTestSuite() { init_attack_tables(); }
+};
+
+static const int fairyCodes[] = { 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 18, 21, 22 };
+
+static Bitboard compiled(int code, int sq, Bitboard occ) {
+    return piece_attacks(fairyPieces[code], sq, occ);
+}
+
+TEST_F(FairyTest, CompiledTablesMatchOnTheFly) {
+    std::mt19937_64 rng(0xFA1AULL);
+    for (int code : fairyCodes) {
+        PieceMoves moves = moveset_moves(code);
+        for (int i = 0; i < 2000; i++) {
+            int sq = (int)(rng() & 63);
+            Bitboard occ = rng() & rng();
+            ASSERT_EQ(compiled(code, sq, occ), piece_attacks_on_the_fly(moves, sq, occ))
+                << "code " << code << " sq " << sq << " occ " << occ;
+        }
+    }
+}
+
+TEST_F(FairyTest, OneWaySlidersMakeARook) {
+    std::mt19937_64 rng(0x700CULL);
+    for (int i = 0; i < 2000; i++) {
+        int sq = (int)(rng() & 63);
+        Bitboard occ = rng() & rng();
+        Bitboard rook = fairy_attacks<4>(sq, occ) | fairy_attacks<5>(sq, occ)
+                      | fairy_attacks<6>(sq, occ) | fairy_attacks<7>(sq, occ);
+        Bitboard bishop = fairy_attacks<8>(sq, occ) | fairy_attacks<9>(sq, occ)
+                        | fairy_attacks<10>(sq, occ) | fairy_attacks<11>(sq, occ);
+        EXPECT_EQ(rook, rook_attacks(sq, occ));
+        EXPECT_EQ(bishop, bishop_attacks(sq, occ));
+    }
+}
+
+TEST_F(FairyTest, SpaceJumpLandsBehindTheHurdle) {
+    // Rook-like hopper on d4 (27): hurdle on d6, lands on d7
+    Bitboard occ = 1ULL << 43;
+    EXPECT_EQ(fairy_attacks<18>(27, occ), 1ULL << 51);
+    EXPECT_EQ(fairy_attacks<13>(27, occ), 1ULL << 51);
+    EXPECT_EQ(fairy_attacks<14>(27, occ), 0ULL);
+
+    // Hurdle on the edge: nowhere to land
+    EXPECT_EQ(fairy_attacks<18>(27, 1ULL << 59), 0ULL);
+    EXPECT_EQ(fairy_attacks<12>(27, 0ULL), 0ULL);
+}
+
+TEST_F(FairyTest, LargeKnightAndQueen) {
+    // Camel on a1 reaches b4 and d2
+    EXPECT_EQ(fairy_attacks<21>(0, 0ULL), (1ULL << 25) | (1ULL << 11));
+    for (int sq = 0; sq < 64; sq++) {
+        Bitboard occ = 0x00FF00000000FF00ULL;
+        EXPECT_EQ(fairy_attacks<22>(sq, occ),
+                  rook_attacks(sq, occ) | bishop_attacks(sq, occ) | fairy_attacks<21>(sq, occ));
+    }
+    EXPECT_TRUE(fairyPieces[22].rookRider);
+    EXPECT_TRUE(fairyPieces[22].bishopRider);
+    EXPECT_TRUE(fairyPieces[22].rays.empty());
+}
+
+TEST_F(FairyTest, UnsupportedCodesThrow) {
+    EXPECT_THROW(moveset_moves(15), std::invalid_argument);
+    EXPECT_THROW(moveset_moves(1), std::invalid_argument);
+}
@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+#include "variant_test.h"
+
+class HistoryTest : public VariantTest {
+protected:
+    History history;
+
+    void start(const std::string& gameMode, const std::string& fen = "") {
+        VariantTest::start(gameMode, fen);
+        history.clear();
+        history.push(bb.zobrist_hash);
+    }
+
+    void play(int from, int to) {
+        UndoInfo undo;
+        make_move(bb, make_move_code(from, to), undo, z);
+        history.push(bb.zobrist_hash);
+    }
+};
+
+TEST_F(HistoryTest, KnightShuffleRepeats) {
+    start("QE chess");
+    for (int round = 1; round <= 2; round++) {
+        play(6, 21);  play(62, 45);     // Nf3 Nf6
+        EXPECT_EQ(is_draw(bb, rules, history), round == 2);
+        play(21, 6);  play(45, 62);     // Ng1 Ng8
+        EXPECT_TRUE(is_draw(bb, rules, history));
+        EXPECT_EQ(is_draw(bb, rules, history, 2), round == 2);
+    }
+}
+
+TEST_F(HistoryTest, IrreversibleMoveBoundsTheScan) {
+    start("QE chess");
+    play(6, 21);  play(62, 45);
+    play(21, 6);  play(45, 62);
+    ASSERT_EQ(history.repetitions(bb.halfmove_clock, 2), 1);
+    // Same position, but a clock of 0 says nothing before it can match
+    EXPECT_EQ(history.repetitions(0, 2), 0);
+}
+
+TEST_F(HistoryTest, MarseillaisScansEveryEntry) {
+    // A check ends a turn early, so turns are not all the same length
+    start("Marseillais Chess");
+    EXPECT_EQ(repetition_stride(rules), 1);
+    play(6, 21);  play(1, 18);          // Nf3 and Nc3
+    play(62, 45); play(57, 42);         // ...Nf6 and ...Nc6
+    play(21, 6);  play(18, 1);
+    play(45, 62);
+    EXPECT_FALSE(is_draw(bb, rules, history));
+    play(42, 57);
+    EXPECT_TRUE(is_draw(bb, rules, history));
+}
+
+TEST_F(HistoryTest, FiftyMoveRule) {
+    start("QE chess", "4k3/8/8/8/8/8/8/R3K3 w - - 99 80");
+    EXPECT_FALSE(is_draw(bb, rules, history));
+    play(0, 8);
+    EXPECT_TRUE(is_draw(bb, rules, history));
+
+    start("Marseillais Chess", "4k3/8/8/8/8/8/8/R3K3 w - - 100 80");
+    EXPECT_FALSE(is_draw(bb, rules, history));
+    EXPECT_EQ(fifty_move_limit(rules), 200);
+}
+
+TEST_F(HistoryTest, FlockTurnsIncludeTheDuck) {
+    start("Flock-Chess");
+    EXPECT_EQ(repetition_stride(rules), 4);
+    EXPECT_EQ(fifty_move_limit(rules), 100);
+
+    // Knights out and back, the c4 duck stepping to d3 and back each turn
+    const int moves[][2] = { { 6, 21 }, { 26, 19 }, { 62, 45 }, { 19, 26 },
+                             { 21, 6 }, { 26, 19 }, { 45, 62 }, { 19, 26 } };
+    for (const auto& m : moves) {
+        EXPECT_FALSE(is_draw(bb, rules, history));
+        play(m[0], m[1]);
+    }
+    EXPECT_EQ(bb.halfmove_clock, 4);    // duck moves do not tick the clock
+    EXPECT_TRUE(is_draw(bb, rules, history));
+}
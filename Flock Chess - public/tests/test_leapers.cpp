@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+#include "knight.h"
+#include "king.h"
+#include "pawn.h"
+
+// The tables are compile-time constants
+static_assert(knightAttacks[0] == 0x0000000000020400ULL, "knight a1");
+static_assert(kingAttacks[0] == 0x0000000000000302ULL, "king a1");
+static_assert(whitePawnAttacks[8] == 0x0000000000020000ULL, "white pawn a2");
+static_assert(blackPawnAttacks[63] == 0ULL + (1ULL << 54), "black pawn h8");
+
+// Reference masks, written the way the old runtime initializers filled the
+// tables: walk the offsets and keep the on-board squares.
+static Bitboard reference_leaper(int sq, const int (*offsets)[2], int count) {
+    Bitboard bb = 0ULL;
+    int r = sq / 8, f = sq % 8;
+    for (int i = 0; i < count; i++) {
+        int rr = r + offsets[i][0];
+        int ff = f + offsets[i][1];
+        if (rr >= 0 && rr < 8 && ff >= 0 && ff < 8)
+            bb |= 1ULL << (rr * 8 + ff);
+    }
+    return bb;
+}
+
+TEST(LeaperTablesTest, KnightMatchesRuntimeMask) {
+    const int offsets[8][2] = { {2,1}, {2,-1}, {-2,1}, {-2,-1}, {1,2}, {1,-2}, {-1,2}, {-1,-2} };
+    for (int sq = 0; sq < 64; sq++) {
+        EXPECT_EQ(knight_attacks(sq, ~0ULL), reference_leaper(sq, offsets, 8)) << "sq " << sq;
+        EXPECT_EQ(knight_attacks(sq, 0ULL), knight_mask(sq)) << "sq " << sq;
+    }
+}
+
+TEST(LeaperTablesTest, KingMatchesRuntimeMask) {
+    const int offsets[8][2] = { {1,1}, {1,0}, {1,-1}, {0,1}, {0,-1}, {-1,1}, {-1,0}, {-1,-1} };
+    for (int sq = 0; sq < 64; sq++) {
+        EXPECT_EQ(king_attacks(sq, ~0ULL), reference_leaper(sq, offsets, 8)) << "sq " << sq;
+        EXPECT_EQ(king_attacks(sq, 0ULL), king_mask(sq)) << "sq " << sq;
+    }
+}
+
+TEST(LeaperTablesTest, PawnsMatchRuntimeMask) {
+    const int white[2][2] = { {1,-1}, {1,1} };
+    const int black[2][2] = { {-1,-1}, {-1,1} };
+    for (int sq = 0; sq < 64; sq++) {
+        // Pawns on their own promotion rank have no attacks
+        Bitboard w = (sq / 8 == 7) ? 0ULL : reference_leaper(sq, white, 2);
+        Bitboard b = (sq / 8 == 0) ? 0ULL : reference_leaper(sq, black, 2);
+        EXPECT_EQ(white_pawn_attacks(sq, 0ULL), w) << "sq " << sq;
+        EXPECT_EQ(black_pawn_attacks(sq, 0ULL), b) << "sq " << sq;
+        EXPECT_EQ(white_pawn_attacks(sq, 0ULL), white_pawn_mask(sq)) << "sq " << sq;
+        EXPECT_EQ(black_pawn_attacks(sq, 0ULL), black_pawn_mask(sq)) << "sq " << sq;
+    }
+}
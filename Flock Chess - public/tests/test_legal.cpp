@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include "legal.h"
+
+static const std::vector<char> PIECES = { 'K', 'Q', 'R', 'B', 'N', 'P', 'k', 'q', 'r', 'b', 'n', 'p' };
+
+class LegalTest : public ::testing::Test {
+protected:
+    Zobrist z;
+
+    void SetUp() override { init_zobrist(z, PIECES, 0); }
+
+    Bitboards board(const std::string& fen) {
+        Bitboards bb = parse_fen_bitboards(fen, PIECES);
+        bb.zobrist_hash = compute_zobrist(bb, z);
+        return bb;
+    }
+
+    uint64_t perft(Bitboards& bb, int depth) {
+        MoveList list;
+        generate_legal(bb, list);
+        if (depth == 1)
+            return list.size;
+
+        uint64_t nodes = 0;
+        for (Move m : list) {
+            UndoInfo undo;
+            make_move(bb, m, undo, z);
+            nodes += perft(bb, depth - 1);
+            unmake_move(bb, m, undo);
+        }
+        return nodes;
+    }
+
+    // Pseudo-legal moves that do not leave the mover's king attacked
+    std::vector<Move> make_and_test(Bitboards& bb) {
+        MoveList list;
+        generate_pseudo_legal(bb, list);
+        std::vector<Move> legal;
+        bool white = bb.w_to_move;
+        for (Move m : list) {
+            UndoInfo undo;
+            make_move(bb, m, undo, z);
+            if (!king_in_check(bb, white))
+                legal.push_back(m);
+            unmake_move(bb, m, undo);
+        }
+        return legal;
+    }
+};
+
+static const char* KIWIPETE = "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1";
+static const char* ENDGAME = "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1";
+static const char* PROMOTIONS = "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1";
+static const char* TALKCHESS = "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8";
+
+TEST_F(LegalTest, PerftStartPosition) {
+    Bitboards bb = board("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1");
+    EXPECT_EQ(perft(bb, 1), 20u);
+    EXPECT_EQ(perft(bb, 2), 400u);
+    EXPECT_EQ(perft(bb, 3), 8902u);
+    EXPECT_EQ(perft(bb, 4), 197281u);
+}
+
+TEST_F(LegalTest, PerftKiwipete) {
+    Bitboards bb = board(KIWIPETE);
+    EXPECT_EQ(perft(bb, 1), 48u);
+    EXPECT_EQ(perft(bb, 2), 2039u);
+    EXPECT_EQ(perft(bb, 3), 97862u);
+}
+
+TEST_F(LegalTest, PerftEnPassantPins) {
+    Bitboards bb = board(ENDGAME);
+    EXPECT_EQ(perft(bb, 1), 14u);
+    EXPECT_EQ(perft(bb, 2), 191u);
+    EXPECT_EQ(perft(bb, 3), 2812u);
+    EXPECT_EQ(perft(bb, 4), 43238u);
+}
+
+TEST_F(LegalTest, PerftPromotionsAndChecks) {
+    Bitboards bb = board(PROMOTIONS);
+    EXPECT_EQ(perft(bb, 1), 6u);
+    EXPECT_EQ(perft(bb, 2), 264u);
+    EXPECT_EQ(perft(bb, 3), 9467u);
+
+    bb = board(TALKCHESS);
+    EXPECT_EQ(perft(bb, 1), 44u);
+    EXPECT_EQ(perft(bb, 2), 1486u);
+    EXPECT_EQ(perft(bb, 3), 62379u);
+}
+
+TEST_F(LegalTest, MatchesMakeAndTest) {
+    const char* fens[] = {
+        KIWIPETE, ENDGAME, PROMOTIONS, TALKCHESS,
+        "4k3/8/8/2KPp2r/8/8/8/8 w - e6 0 2",          // en passant exposes the king
+        "4k3/4r3/8/8/8/8/3PPP2/3QKB2 w - - 0 1",      // pinned pawn may still push
+        "4k3/8/8/1b6/8/8/4N3/r3K2R w K - 0 1",        // double check
+    };
+    for (const char* fen : fens) {
+        Bitboards bb = board(fen);
+        MoveList list;
+        generate_legal(bb, list);
+        std::vector<Move> legal(list.begin(), list.end());
+        std::vector<Move> expected = make_and_test(bb);
+        std::sort(legal.begin(), legal.end());
+        std::sort(expected.begin(), expected.end());
+        EXPECT_EQ(legal, expected) << fen;
+    }
+}
+
+TEST_F(LegalTest, CapturesAndQuietsSplitAllMoves) {
+    const char* fens[] = { KIWIPETE, ENDGAME, PROMOTIONS, TALKCHESS, "4k3/8/8/1b6/8/8/4N3/r3K2R w K - 0 1" };
+    for (const char* fen : fens) {
+        Bitboards bb = board(fen);
+        MoveList all, captures, quiets;
+        generate_legal(bb, all);
+        generate_legal(bb, captures, CAPTURES);
+        generate_legal(bb, quiets, QUIETS);
+        for (Move m : captures)
+            EXPECT_TRUE(move_is_capture(m)) << fen;
+        for (Move m : quiets)
+            EXPECT_FALSE(move_is_capture(m)) << fen;
+
+        std::vector<Move> split(captures.begin(), captures.end());
+        split.insert(split.end(), quiets.begin(), quiets.end());
+        std::vector<Move> expected(all.begin(), all.end());
+        std::sort(split.begin(), split.end());
+        std::sort(expected.begin(), expected.end());
+        EXPECT_EQ(split, expected) << fen;
+    }
+}
+
+TEST_F(LegalTest, NeutralPiecesOnlyBlock) {
+    Bitboards bb = parse_fen_bitboards("4k3/8/8/8/8/8/8/R2DK3 w - - 0 1", PIECES, { 'D' });
+    MoveList list;
+    generate_legal(bb, list);
+    for (Move m : list)
+        EXPECT_NE(move_to(m), 3) << "captured the neutral piece";
+    EXPECT_EQ(std::count_if(list.begin(), list.end(), [](Move m) { return move_from(m) == 0; }), 9);
+}
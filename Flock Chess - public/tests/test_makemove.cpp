@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include "makemove.h"
+
+static const std::vector<char> PIECES = { 'K', 'Q', 'R', 'B', 'N', 'P', 'k', 'q', 'r', 'b', 'n', 'p', 'D' };
+
+static void expect_same(const Bitboards& a, const Bitboards& b) {
+    EXPECT_EQ(a.occupancy, b.occupancy);
+    EXPECT_EQ(a.w_occupancy, b.w_occupancy);
+    EXPECT_EQ(a.b_occupancy, b.b_occupancy);
+    EXPECT_EQ(a.n_occupancy, b.n_occupancy);
+    EXPECT_EQ(a.pieceBB, b.pieceBB);
+    EXPECT_EQ(a.mailbox, b.mailbox);
+    EXPECT_EQ(castling_bits(a), castling_bits(b));
+    EXPECT_EQ(a.enpassant_sq, b.enpassant_sq);
+    EXPECT_EQ(a.halfmove_clock, b.halfmove_clock);
+    EXPECT_EQ(a.fullmove_number, b.fullmove_number);
+    EXPECT_EQ(a.w_to_move, b.w_to_move);
+    EXPECT_EQ(a.sub_move, b.sub_move);
+    EXPECT_EQ(a.zobrist_hash, b.zobrist_hash);
+}
+
+class MakeMoveTest : public ::testing::Test {
+protected:
+    Zobrist z;
+
+    void SetUp() override { init_zobrist(z, PIECES, 0); }
+
+    Bitboards board(const std::string& fen) {
+        Bitboards bb = parse_fen_bitboards(fen, PIECES, { 'D' });
+        bb.zobrist_hash = compute_zobrist(bb, z);
+        return bb;
+    }
+
+    // Makes m, checks the incremental hash, unmakes and checks the board
+    // is restored; returns the board as it was after the move.
+    Bitboards round_trip(Bitboards& bb, Move m) {
+        Bitboards before = bb;
+        UndoInfo undo;
+        make_move(bb, m, undo, z);
+        EXPECT_EQ(bb.zobrist_hash, compute_zobrist(bb, z));
+        Bitboards after = bb;
+        unmake_move(bb, m, undo);
+        expect_same(bb, before);
+        return after;
+    }
+};
+
+static int sq(const char* name) { return (name[1] - '1') * 8 + (name[0] - 'a'); }
+
+TEST(MoveEncodingTest, FieldsRoundTrip) {
+    Move m = make_move_code(12, 28, DOUBLE_PUSH, false, 0, 33, 41);
+    EXPECT_EQ(move_from(m), 12);
+    EXPECT_EQ(move_to(m), 28);
+    EXPECT_EQ(move_type(m), DOUBLE_PUSH);
+    EXPECT_FALSE(move_is_capture(m));
+    EXPECT_TRUE(move_has_duck(m));
+    EXPECT_EQ(move_duck_to(with_duck(m, 41, 49)), 49);
+
+    Move p = make_move_code(52, 61, PROMOTION, true, 15);
+    EXPECT_EQ(move_promo(p), 15);
+    EXPECT_TRUE(move_is_capture(p));
+    EXPECT_FALSE(move_has_duck(p));
+}
+
+TEST_F(MakeMoveTest, QuietCaptureAndClocks) {
+    Bitboards bb = board("rnbqkbnr/ppp1pppp/8/3p4/4P3/8/PPPP1PPP/RNBQKBNR w KQkq - 3 2");
+    Bitboards after = round_trip(bb, make_move_code(sq("g1"), sq("f3")));
+    EXPECT_EQ(after.piece_on(sq("f3")), 'N');
+    EXPECT_EQ(after.halfmove_clock, 4);
+    EXPECT_FALSE(after.w_to_move);
+
+    after = round_trip(bb, make_move_code(sq("e4"), sq("d5"), NORMAL, true));
+    EXPECT_EQ(after.piece_on(sq("d5")), 'P');
+    EXPECT_EQ(after.piece_board('p') & (1ULL << sq("d5")), 0ULL);
+    EXPECT_EQ(after.halfmove_clock, 0);
+}
+
+TEST_F(MakeMoveTest, DoublePushAndEnPassant) {
+    Bitboards bb = board("4k3/8/8/8/3p4/8/4P3/4K3 w - - 0 1");
+    Move push = make_move_code(sq("e2"), sq("e4"), DOUBLE_PUSH);
+    Bitboards after = round_trip(bb, push);
+    EXPECT_EQ(after.enpassant_sq, 1ULL << sq("e3"));
+
+    UndoInfo u1;
+    make_move(bb, push, u1, z);
+    Move ep = make_move_code(sq("d4"), sq("e3"), EN_PASSANT, true);
+    after = round_trip(bb, ep);
+    EXPECT_EQ(after.piece_board('P'), 0ULL);
+    EXPECT_EQ(after.piece_on(sq("e3")), 'p');
+    EXPECT_EQ(after.enpassant_sq, 0ULL);
+    EXPECT_EQ(after.fullmove_number, 2);
+}
+
+TEST_F(MakeMoveTest, CastlingMovesTheRookAndDropsRights) {
+    Bitboards bb = board("r3k2r/8/8/8/8/8/8/R3K2R w KQkq - 0 1");
+    Bitboards after = round_trip(bb, make_move_code(sq("e1"), sq("g1"), CASTLE_KING));
+    EXPECT_EQ(after.piece_on(sq("f1")), 'R');
+    EXPECT_EQ(after.piece_on(sq("h1")), 0);
+    EXPECT_EQ(castling_bits(after), B_KINGSIDE | B_QUEENSIDE);
+
+    after = round_trip(bb, make_move_code(sq("e1"), sq("c1"), CASTLE_QUEEN));
+    EXPECT_EQ(after.piece_on(sq("d1")), 'R');
+    EXPECT_EQ(after.piece_on(sq("a1")), 0);
+
+    // Taking a rook on its corner removes that right
+    after = round_trip(bb, make_move_code(sq("a1"), sq("a8"), NORMAL, true));
+    EXPECT_EQ(castling_bits(after), W_KINGSIDE | B_KINGSIDE);
+}
+
+TEST_F(MakeMoveTest, PromotionWithCapture) {
+    Bitboards bb = board("1n2k3/P7/8/8/8/8/8/4K3 w - - 0 1");
+    int queen = bb.piece_id('Q');
+    Bitboards after = round_trip(bb, make_move_code(sq("a7"), sq("b8"), PROMOTION, true, queen));
+    EXPECT_EQ(after.piece_on(sq("b8")), 'Q');
+    EXPECT_EQ(after.piece_board('P'), 0ULL);
+    EXPECT_EQ(after.piece_board('n'), 0ULL);
+}
+
+TEST_F(MakeMoveTest, DuckRelocationAndMultiMoveTurns) {
+    Bitboards bb = board("4k3/8/8/8/3D4/8/8/4K3 w - - 0 1");
+    Move m = with_duck(make_move_code(sq("e1"), sq("e2")), sq("d4"), sq("e5"));
+    Bitboards after = round_trip(bb, m);
+    EXPECT_EQ(after.n_occupancy, 1ULL << sq("e5"));
+    EXPECT_EQ(after.piece_on(sq("e5")), 'D');
+
+    // Marseillais: two sub-moves before the turn passes
+    bb.moves_per_turn = 2;
+    UndoInfo u1;
+    Move first = make_move_code(sq("e1"), sq("d1"));
+    after = round_trip(bb, first);
+    EXPECT_TRUE(after.w_to_move);
+    EXPECT_EQ(after.sub_move, 1);
+
+    make_move(bb, first, u1, z);
+    after = round_trip(bb, make_move_code(sq("d1"), sq("c1")));
+    EXPECT_FALSE(after.w_to_move);
+    EXPECT_EQ(after.sub_move, 0);
+}
@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include "movegen.h"
+
+// Counts every global allocation made by this test binary
+static std::atomic<long> allocations{0};
+
+void* operator new(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+static const char* FLOCK_START = "rnbqkbnr/pppppppp/8/1D1D1D/2D1D1/8/PPPPPPPP/RNBQKBNR w KQkq - 0-1";
+
+static PiecePrograms flock_programs() {
+    const char* pieces = "KQRBNPkqrbnpD";
+    const char* movesets[] = { "16", "1+2+3", "1", "2", "3", "17",
+                               "16", "1+2+3", "1", "2", "3", "20", "19" };
+    PiecePrograms programs{};
+    for (int i = 0; pieces[i]; i++)
+        programs[(unsigned char)pieces[i]] = compile_moveset(movesets[i]);
+    return programs;
+}
+
+TEST(MovegenAllocTest, BufferApiDoesNotAllocate) {
+    init_attack_tables();
+    PiecePrograms programs = flock_programs();
+    Bitboards bb = parse_fen_bitboards(FLOCK_START);
+    MoveBoards expected = movegen(bb, programs);
+    MoveBoards out;
+
+    long before = allocations.load();
+    for (int i = 0; i < 1000; i++)
+        movegen(bb, programs, out);
+    long after = allocations.load();
+
+    EXPECT_EQ(after - before, 0);
+    EXPECT_EQ(out, expected);
+}
+
+TEST(MovegenAllocTest, CounterSeesAllocations) {
+    long before = allocations.load();
+    Bitboards bb = parse_fen_bitboards(FLOCK_START);
+    bb.quantum_state.push_back(1);
+    EXPECT_GT(allocations.load() - before, 0);
+}
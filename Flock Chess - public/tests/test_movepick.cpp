@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include "movepick.h"
+#include "variant_test.h"
+
+class MovePickTest : public VariantTest {
+protected:
+    Evaluator ev;
+    PieceToTable<int> history{};
+    Move noKillers[2] = { NO_MOVE, NO_MOVE };
+
+    void start(const std::string& gameMode, const std::string& fen) {
+        VariantTest::start(gameMode, fen);
+        ev = make_evaluator(bb, rules);
+    }
+
+    std::vector<Move> pick_all(Move ttMove, const Move killers[2], Move counter) {
+        MovePicker picker(bb, rules, ev, history, ttMove, killers, counter);
+        std::vector<Move> moves;
+        for (Move m = picker.next(); m != NO_MOVE; m = picker.next())
+            moves.push_back(m);
+        return moves;
+    }
+
+    std::vector<Move> generated() {
+        MoveList list;
+        generate_moves(bb, rules, list);
+        return { list.begin(), list.end() };
+    }
+};
+
+static const char* KIWIPETE = "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1";
+
+TEST_F(MovePickTest, EveryMoveExactlyOnce) {
+    const std::pair<const char*, const char*> positions[] = {
+        { "QE chess", KIWIPETE },
+        { "QE chess", "4k3/8/8/1b6/8/8/4N3/r3K2R w K - 0 1" },
+        { "Marseillais Chess", "" },
+        { "Flock-Chess", "" },
+        { "Flock-Chess", "r1bqkb1r/pppp1ppp/2n2n2/4p3/2B1P3/3D1N2/PPPP1PPP/RNBQK2R w KQkq - 0 4" },
+    };
+    for (const auto& [gameMode, fen] : positions) {
+        start(gameMode, fen);
+        std::vector<Move> expected = generated();
+        ASSERT_FALSE(expected.empty());
+
+        // A TT move and refutations from elsewhere: one real, the rest bogus
+        Move killers[2] = { expected.back(), make_move_code(63, 0) };
+        std::vector<Move> picked = pick_all(expected[expected.size() / 2], killers, make_move_code(1, 2));
+
+        std::sort(picked.begin(), picked.end());
+        std::sort(expected.begin(), expected.end());
+        EXPECT_EQ(picked, expected) << gameMode << " " << fen;
+    }
+}
+
+TEST_F(MovePickTest, QuietTTMoveCheckMatchesTheGenerator) {
+    // Positions with pins, check, castling, promotions and a duck sub-move;
+    // every move of any of them is a candidate TT move in all of them
+    const std::pair<const char*, const char*> positions[] = {
+        { "QE chess", KIWIPETE },
+        { "QE chess", "4k3/8/8/1b6/8/8/4N3/r3K2R w K - 0 1" },
+        { "QE chess", "r3k2r/8/8/8/8/8/8/R3K2R b KQkq - 0 1" },
+        { "QE chess", "r3k2r/8/8/8/8/8/5b2/R3K2R w KQkq - 0 1" },
+        { "QE chess", "8/P3k3/8/8/8/8/6p1/4K3 w - - 0 1" },
+        { "Marseillais Chess", "" },
+        { "Flock-Chess", "" },
+        { "Flock-Chess", "r3k2r/P7/8/8/8/3D4/8/R3K2R w KQkq - 0 1" },
+    };
+    std::vector<std::pair<GameRules, Bitboards>> boards;
+    std::vector<Move> candidates;
+    auto add = [&]() {
+        boards.emplace_back(rules, bb);
+        MoveList list;
+        generate_moves(bb, rules, list);
+        candidates.insert(candidates.end(), list.begin(), list.end());
+        generate_pseudo_legal(bb, list);
+        candidates.insert(candidates.end(), list.begin(), list.end());
+    };
+    for (const auto& [gameMode, fen] : positions) {
+        start(gameMode, fen);
+        add();
+        if (rules.flock) {
+            UndoInfo undo;
+            play_move(bb, generated().front(), undo, z, rules);
+            add();
+        }
+    }
+
+    for (const auto& [r, b] : boards) {
+        MoveList quiets;
+        generate_moves(b, r, quiets, QUIETS);
+        for (Move m : candidates) {
+            bool expected = std::find(quiets.begin(), quiets.end(), m) != quiets.end();
+            EXPECT_EQ(is_quiet_move(b, r, m), expected) << move_to_string(b, m);
+        }
+    }
+}
+
+TEST_F(MovePickTest, StagesInOrder) {
+    // White can take the queen with the pawn or the rook, or a pawn
+    start("QE chess", "4k3/8/8/2q1p3/1P6/8/8/2R1K3 w - - 0 1");
+    const Move pxq = make_move_code(25, 34, NORMAL, true);
+    const Move rxq = make_move_code(2, 34, NORMAL, true);
+    const Move killer = make_move_code(4, 5);           // Kf1
+    const Move counter = make_move_code(25, 33);        // b5
+    const Move tt = make_move_code(2, 10);              // Rc2
+    Move killers[2] = { killer, NO_MOVE };
+
+    std::vector<Move> picked = pick_all(tt, killers, counter);
+    ASSERT_GE(picked.size(), 5u);
+    EXPECT_EQ(picked[0], tt);
+    EXPECT_EQ(picked[1], pxq);          // least valuable attacker first
+    EXPECT_EQ(picked[2], rxq);
+    EXPECT_EQ(picked[3], killer);
+    EXPECT_EQ(picked[4], counter);
+    for (size_t i = 5; i < picked.size(); i++)
+        EXPECT_FALSE(move_is_capture(picked[i]));
+}
+
+TEST_F(MovePickTest, QuietsFollowHistory) {
+    start("QE chess", "4k3/8/8/8/8/8/8/R3K3 w - - 0 1");
+    const Move favourite = make_move_code(0, 40);       // Ra6
+    history[bb.mailbox[0]][40] = 500;
+    std::vector<Move> picked = pick_all(NO_MOVE, noKillers, NO_MOVE);
+    ASSERT_FALSE(picked.empty());
+    EXPECT_EQ(picked[0], favourite);
+}
+
+TEST_F(MovePickTest, FlockKingCaptureFirst) {
+    start("Flock-Chess", "4k3/8/8/8/1q6/D7/8/4QK2 w - - 0 1");
+    std::vector<Move> picked = pick_all(NO_MOVE, noKillers, NO_MOVE);
+    ASSERT_FALSE(picked.empty());
+    EXPECT_EQ(picked[0], make_move_code(4, 60, NORMAL, true));
+}
+
+TEST_F(MovePickTest, QuiescencePromotesAndPrunesLosingTTMove) {
+    // Qxd5 loses the queen to ...exd5; a8=Q is the one quiet move kept
+    start("QE chess", "4k3/P7/4p3/3p4/8/8/8/3QK3 w - - 0 1");
+    MovePicker picker(bb, rules, ev, make_move_code(3, 35, NORMAL, true));
+    std::vector<Move> picked;
+    for (Move m = picker.next(); m != NO_MOVE; m = picker.next())
+        picked.push_back(m);
+    EXPECT_EQ(picked, (std::vector<Move>{ make_move_code(48, 56, PROMOTION, false, bb.piece_id('Q')) }));
+}
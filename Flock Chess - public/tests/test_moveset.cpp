@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include "attacks.h"
+
+TEST(MovesetProgramTest, TermsAreXored) {
+    init_attack_tables();
+    AttackProgram queen = compile_moveset("1+2");
+    AttackProgram amazon = compile_moveset("1+2+3");
+    AttackProgram twice = compile_moveset("3+3");
+    ASSERT_EQ(amazon.count, 3);
+
+    Bitboard occ = 0x00FF00000000FF00ULL;
+    for (int sq = 0; sq < 64; sq++) {
+        EXPECT_EQ(queen(sq, occ), rook_attacks(sq, occ) ^ bishop_attacks(sq, occ));
+        EXPECT_EQ(amazon(sq, occ), queen(sq, occ) ^ knight_attacks(sq, occ));
+        EXPECT_EQ(twice(sq, occ), 0ULL);
+    }
+    EXPECT_EQ(compile_moveset(" 19 ")(27, occ), duck_attacks(27, occ));
+    EXPECT_EQ(compile_moveset("21")(0, 0ULL), fairy_attacks<21>(0, 0ULL));
+}
+
+TEST(MovesetProgramTest, RejectsBadExpressions) {
+    EXPECT_THROW(compile_moveset("15"), std::runtime_error);
+    EXPECT_THROW(compile_moveset("99"), std::runtime_error);
+    EXPECT_THROW(compile_moveset("1+x"), std::runtime_error);
+    EXPECT_THROW(compile_moveset(""), std::runtime_error);
+    EXPECT_THROW(compile_moveset("1+1+1+1+1+1+1+1+1"), std::runtime_error);
+}
+
+TEST(MovesetProgramTest, ReverseFindsTheAttackers) {
+    init_attack_tables();
+    // Every code with a mirror, alone and combined, against random boards
+    const char* exprs[] = { "1", "2", "3", "4", "5", "6", "7", "8", "9", "10", "11",
+                            "16", "17", "20", "21", "22", "1+2+3", "4+9", "22+1" };
+    uint64_t seed = 0x2545F4914F6CDD1DULL;
+    for (const char* expr : exprs) {
+        AttackProgram program = compile_moveset(expr);
+        ASSERT_TRUE(program.reversible) << expr;
+        for (int trial = 0; trial < 8; trial++) {
+            seed ^= seed << 13, seed ^= seed >> 7, seed ^= seed << 17;
+            Bitboard occ = seed & (seed >> 3);
+            for (int sq = 0; sq < 64; sq++) {
+                Bitboard expected = 0ULL;
+                for (int from = 0; from < 64; from++)
+                    if ((program(from, occ) >> sq) & 1)
+                        expected |= 1ULL << from;
+                EXPECT_EQ(program.reverse(sq, occ), expected) << expr << " to " << sq;
+            }
+        }
+    }
+    EXPECT_FALSE(compile_moveset("12").reversible);
+    EXPECT_FALSE(compile_moveset("1+19").reversible);
+}
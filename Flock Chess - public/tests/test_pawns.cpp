@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "legal.h"
+
+static PiecePrograms programs_for(const char* pieces, const std::vector<const char*>& movesets) {
+    PiecePrograms programs{};
+    for (size_t i = 0; pieces[i]; i++)
+        programs[(unsigned char)pieces[i]] = compile_moveset(movesets[i]);
+    return programs;
+}
+
+static int sq(const char* name) { return (name[1] - '1') * 8 + (name[0] - 'a'); }
+
+TEST(PawnSetwiseTest, MatchesPerPawnTables) {
+    std::mt19937_64 rng(0x9A3ULL);
+    for (int i = 0; i < 1000; i++) {
+        Bitboard pawns = rng() & rng() & ~(RANK_1_BB | RANK_8_BB);
+        Bitboard empty = ~(rng() & rng()) & ~pawns;
+        for (bool white : { true, false }) {
+            Bitboard pushes = 0ULL, doubles = 0ULL, attacks = 0ULL;
+            for (Bitboard b = pawns; b; b &= b - 1) {
+                int from = indexLSB(b);
+                int one = from + pawn_push_offset(white), two = one + pawn_push_offset(white);
+                if ((empty >> one) & 1) {
+                    pushes |= 1ULL << one;
+                    bool home = white ? from / 8 == 1 : from / 8 == 6;
+                    if (home && ((empty >> two) & 1))
+                        doubles |= 1ULL << two;
+                }
+                attacks |= white ? whitePawnAttacks[from] : blackPawnAttacks[from];
+            }
+            Bitboard got = pawn_pushes(pawns, empty, white);
+            EXPECT_EQ(got, pushes);
+            EXPECT_EQ(pawn_double_pushes(got, empty, white), doubles);
+            EXPECT_EQ(pawn_west_attacks(pawns, white) | pawn_east_attacks(pawns, white), attacks);
+        }
+    }
+}
+
+TEST(PawnTargetsTest, PushesCapturesAndDucks) {
+    init_attack_tables();
+    PiecePrograms programs = programs_for("KPkpD", { "16", "17", "16", "20", "19" });
+    // e2 is blocked two squares up by a duck, c2 one square up; d5 may
+    // take e6 en passant but not the duck on c6
+    Bitboards bb = parse_fen_bitboards("4k3/8/2+D5/3Pp3/4+D3/2+D5/2P1P3/4K3 w - e6 0 2");
+    MoveTargets t;
+    movegen(bb, programs, t);
+    EXPECT_EQ(t.quiet[sq("e2")], 1ULL << sq("e3"));
+    EXPECT_EQ(t.quiet[sq("c2")], 0ULL);
+    EXPECT_EQ(t.quiet[sq("d5")], 1ULL << sq("d6"));
+    EXPECT_EQ(t.captures[sq("d5")], 1ULL << sq("e6"));
+    EXPECT_EQ(t.quiet[sq("e5")], 0ULL);                        // the duck on e4 blocks
+    EXPECT_EQ(t.captures[sq("e5")], 0ULL);
+
+    Bitboards start = parse_fen_bitboards("4k3/p7/8/8/8/8/P7/4K3 w - - 0 1");
+    movegen(start, programs, t);
+    EXPECT_EQ(t.quiet[sq("a2")], (1ULL << sq("a3")) | (1ULL << sq("a4")));
+    EXPECT_EQ(t.quiet[sq("a7")], (1ULL << sq("a6")) | (1ULL << sq("a5")));
+}
+
+TEST(PawnPromotionTest, FollowsTheVariantPieceSet) {
+    // An amazon-style 'A' replaces the rook, bishop and knight
+    const std::vector<char> pieces = { 'K', 'A', 'Q', 'P', 'k', 'a', 'q', 'p', 'D' };
+    Bitboards bb = parse_fen_bitboards("1n2k3/P7/8/8/8/8/8/4K3 w - - 0 1", pieces, { 'D' });
+
+    PromotionSet white = promotion_pieces(bb, true);
+    ASSERT_EQ(white.count, 2);
+    EXPECT_EQ(bb.pieceChar[white.ids[0]], 'A');
+    EXPECT_EQ(bb.pieceChar[white.ids[1]], 'Q');
+
+    MoveList list;
+    generate_legal(bb, list);
+    int promotions = 0, captures = 0;
+    for (Move m : list) {
+        if (move_type(m) != PROMOTION)
+            continue;
+        promotions++;
+        captures += move_is_capture(m);
+    }
+    EXPECT_EQ(promotions, 4);       // a8 and xb8, two pieces each
+    EXPECT_EQ(captures, 2);
+}
@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include "perft.h"
+#include "variant_test.h"
+
+// Known node counts. Standard-rules numbers are the published ones; the
+// Flock-Chess and Marseillais ones pin down this generator's rules
+// (rules.h) so a change to them shows up here.
+class PerftTest : public VariantTest {
+protected:
+    uint64_t count(const std::string& gameMode, const std::string& fen, int depth,
+                   int threads = 1, PerftHash* hash = nullptr) {
+        start(gameMode, fen);
+        return perft_divide(bb, rules, z, depth, threads, hash).nodes;
+    }
+};
+
+TEST_F(PerftTest, StandardStartPosition) {
+    const uint64_t expected[] = { 1, 20, 400, 8902, 197281 };
+    for (int depth = 0; depth <= 4; depth++)
+        EXPECT_EQ(count("QE chess", "", depth), expected[depth]) << "depth " << depth;
+}
+
+TEST_F(PerftTest, Kiwipete) {
+    const char* fen = "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1";
+    EXPECT_EQ(count("QE chess", fen, 3), 97862u);
+}
+
+TEST_F(PerftTest, FlockStartPosition) {
+    // Depth counts sub-moves: a piece move, then a duck move
+    const uint64_t expected[] = { 1, 20, 412, 7459, 138801 };
+    for (int depth = 0; depth <= 4; depth++)
+        EXPECT_EQ(count("Flock-Chess", "", depth), expected[depth]) << "depth " << depth;
+}
+
+TEST_F(PerftTest, MarseillaisTwoMovesPerTurn) {
+    EXPECT_EQ(count("Marseillais Chess", "", 1), 20u);
+    EXPECT_EQ(count("Marseillais Chess", "", 2), 445u);      // White moves twice
+    EXPECT_EQ(count("Marseillais Chess", "", 3), 8864u);
+}
+
+TEST_F(PerftTest, MarseillaisOwnDoublePushIsNoEnPassant) {
+    // After e2e4 White is still to move with e3 as the en passant square;
+    // d2 and f2 must not "take" it
+    start("Marseillais Chess");
+    UndoInfo undo;
+    play_move(bb, make_move_code(12, 28, DOUBLE_PUSH), undo, z, rules);
+    ASSERT_TRUE(bb.w_to_move);
+
+    MoveList list;
+    generate_moves(bb, rules, list);
+    EXPECT_EQ(list.size, 30);
+    for (Move m : list)
+        EXPECT_NE(move_type(m), EN_PASSANT) << move_to_string(bb, m);
+    EXPECT_EQ(perft_divide(bb, rules, z, 2).nodes, 592u);
+}
+
+TEST_F(PerftTest, FlockDuckOnTheEnPassantSquare) {
+    // After e2e4 the duck went to e3: ...dxe3 would land on the duck
+    start("Flock-Chess", "4k3/8/8/8/3pP3/4D3/8/4K3 b - e3 0 1");
+    MoveList list;
+    generate_moves(bb, rules, list);
+    for (Move m : list) {
+        EXPECT_NE(move_to(m), 20) << move_to_string(bb, m);
+
+        const Bitboards before = bb;
+        UndoInfo undo;
+        play_move(bb, m, undo, z, rules);
+        EXPECT_EQ(bb.occupancy, bb.w_occupancy | bb.b_occupancy | bb.n_occupancy);
+        EXPECT_EQ(bb.n_occupancy, bb.piece_board('D'));
+        EXPECT_EQ(bb.zobrist_hash, compute_zobrist(bb, z));
+        for (int sq = 0; sq < 64; sq++)
+            EXPECT_EQ(bb.mailbox[sq] != NO_PIECE, ((bb.occupancy >> sq) & 1) != 0) << sq;
+        unmake_move(bb, m, undo);
+        EXPECT_EQ(bb.occupancy, before.occupancy);
+        EXPECT_EQ(bb.mailbox, before.mailbox);
+        EXPECT_EQ(bb.pieceBB, before.pieceBB);
+    }
+}
+
+TEST_F(PerftTest, ThreadsAndHashAgree) {
+    PerftHash hash(4);
+    uint64_t plain = count("Flock-Chess", "", 4);
+    EXPECT_EQ(count("Flock-Chess", "", 4, 3, &hash), plain);
+    EXPECT_EQ(count("Flock-Chess", "", 4, 3, &hash), plain);     // warm table
+
+    PerftHash standard(4);
+    EXPECT_EQ(count("QE chess", "", 4, 2, &standard), 197281u);
+}
+
+TEST_F(PerftTest, DivideSumsToTotal) {
+    start("Flock-Chess");
+
+    PerftResult r = perft_divide(bb, rules, z, 3);
+    ASSERT_EQ(r.divide.size(), 20u);
+    uint64_t sum = 0;
+    for (const auto& [m, nodes] : r.divide)
+        sum += nodes;
+    EXPECT_EQ(sum, r.nodes);
+    EXPECT_EQ(move_to_string(bb, r.divide[0].first), "b1a3");
+}
+
+TEST_F(PerftTest, MarseillaisCheckEndsTheTurn) {
+    // After Ra8+ Black answers at once; White never gets a second sub-move
+    // to take the king
+    start("Marseillais Chess", "4k3/8/8/8/8/8/8/R3K3 w - - 0 1");
+
+    PerftResult r = perft_divide(bb, rules, z, 2);
+    bool found = false;
+    for (const auto& [m, nodes] : r.divide) {
+        if (move_to_string(bb, m) != "a1a8")
+            continue;
+        found = true;
+        EXPECT_EQ(nodes, 3u);           // ...Kd7, ...Ke7, ...Kf7
+    }
+    EXPECT_TRUE(found);
+}
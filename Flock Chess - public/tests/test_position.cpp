@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include "position.h"
+
+static const char* FLOCK_START = "rnbqkbnr/pppppppp/8/1D1D1D/2D1D1/8/PPPPPPPP/RNBQKBNR w KQkq - 0-1";
+
+TEST(PositionTest, RoundTripsThroughBitboards) {
+    Bitboards bb = parse_fen_bitboards("rnbqkbnr/pppppppp/8/1+D6/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0-1");
+    bb.w_q_castle = false;
+    bb.enpassant_sq = 1ULL << 20;
+    bb.halfmove_clock = 3;
+    bb.fullmove_number = 17;
+    bb.zobrist_hash = 0x1234ULL;
+
+    Position pos = to_position(bb);
+    EXPECT_EQ(pos.numTypes, 7);
+    EXPECT_EQ(pos.byColor[NEUTRAL], 1ULL << 33);
+    EXPECT_EQ(pos.pieces(pos.type_of('P'), WHITE), 0x000000000000FF00ULL);
+    EXPECT_EQ(pos.pieces(pos.type_of('p'), BLACK), 0x00FF000000000000ULL);
+    EXPECT_EQ(pos.castling, W_KINGSIDE | B_KINGSIDE | B_QUEENSIDE);
+    EXPECT_EQ(pos.epSquare, 20);
+
+    Bitboards back = to_bitboards(pos);
+    EXPECT_EQ(back.occupancy, bb.occupancy);
+    EXPECT_EQ(back.w_occupancy, bb.w_occupancy);
+    EXPECT_EQ(back.b_occupancy, bb.b_occupancy);
+    EXPECT_EQ(back.pieceBoards(), bb.pieceBoards());
+    for (int sq = 0; sq < 64; sq++)
+        EXPECT_EQ(back.piece_on(sq), bb.piece_on(sq)) << "sq " << sq;
+    EXPECT_EQ(back.w_q_castle, false);
+    EXPECT_EQ(back.b_k_castle, true);
+    EXPECT_EQ(back.enpassant_sq, bb.enpassant_sq);
+    EXPECT_EQ(back.halfmove_clock, 3);
+    EXPECT_EQ(back.fullmove_number, 17);
+    EXPECT_EQ(back.zobrist_hash, 0x1234ULL);
+}
+
+TEST(PositionTest, CopiesAreFlatMemory) {
+    Position pos = to_position(parse_fen_bitboards(FLOCK_START));
+    Position copy;
+    std::memcpy(&copy, &pos, sizeof(Position));
+    EXPECT_EQ(std::memcmp(&copy, &pos, sizeof(Position)), 0);
+
+    copy.move_piece(6, 21);    // Ng1-f3
+    EXPECT_EQ(copy.pieces(copy.type_of('N'), WHITE), (1ULL << 1) | (1ULL << 21));
+    EXPECT_EQ(copy.occupied(), (pos.occupied() & ~(1ULL << 6)) | (1ULL << 21));
+    EXPECT_EQ(pos.pieces(pos.type_of('N'), WHITE), (1ULL << 1) | (1ULL << 6));
+}
@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include "search.h"
+#include "variant_test.h"
+
+class SearchTest : public VariantTest {
+protected:
+    TranspositionTable tt{ 4 };
+
+    SearchResult run(const std::string& gameMode, const std::string& fen, SearchLimits limits) {
+        start(gameMode, fen);
+        tt.clear();
+        Searcher searcher(rules, z, tt);
+        return searcher.search(bb, History(), limits);
+    }
+
+    static SearchLimits depth(int d) {
+        SearchLimits limits;
+        limits.depth = d;
+        return limits;
+    }
+};
+
+TEST_F(SearchTest, BackRankMate) {
+    SearchResult r = run("QE chess", "6k1/5ppp/8/8/8/8/8/R5K1 w - - 0 1", depth(3));
+    EXPECT_EQ(r.best, make_move_code(0, 56));
+    EXPECT_EQ(r.info.score, VALUE_MATE - 1);
+}
+
+TEST_F(SearchTest, StalemateHasNoMove) {
+    SearchResult r = run("QE chess", "7k/5Q2/6K1/8/8/8/8/8 b - - 0 1", depth(2));
+    EXPECT_EQ(r.best, NO_MOVE);
+    EXPECT_EQ(r.info.score, VALUE_DRAW);
+}
+
+TEST_F(SearchTest, FlockTakesTheKing) {
+    SearchResult r = run("Flock-Chess", "4k3/8/8/8/8/D7/8/4QK2 w - - 0 1", depth(2));
+    EXPECT_EQ(r.best, make_move_code(4, 60, NORMAL, true));
+    EXPECT_EQ(r.info.score, VALUE_MATE - 1);
+}
+
+TEST_F(SearchTest, MarseillaisMatesWithinOneTurn) {
+    // Ne4 steps off the e-file without check, then Re8 mates
+    SearchResult r = run("Marseillais Chess", "6k1/5ppp/8/8/4N3/8/8/K3R3 w - - 0 1", depth(3));
+    EXPECT_EQ(r.info.score, VALUE_MATE - 2);
+    ASSERT_GE(r.info.pv.size(), 2u);
+    EXPECT_EQ(move_from(r.info.pv[0]), 28);
+    EXPECT_EQ(r.info.pv[1], make_move_code(4, 60));
+
+    // The same two moves are not a mate when Black replies in between
+    r = run("QE chess", "6k1/5ppp/8/8/4N3/8/8/K3R3 w - - 0 1", depth(3));
+    EXPECT_LT(r.info.score, VALUE_MATE_IN_MAX_PLY);
+}
+
+TEST_F(SearchTest, NodeLimitStops) {
+    SearchLimits limits;
+    limits.nodes = 5000;
+    start("QE chess");
+    Searcher searcher(rules, z, tt);
+    SearchResult r = searcher.search(bb, History(), limits);
+    EXPECT_NE(r.best, NO_MOVE);
+    EXPECT_LT(searcher.node_count(), limits.nodes + 1024);
+}
+
+TEST_F(SearchTest, IterationsReportIncreasingDepth) {
+    start("Flock-Chess");
+    Searcher searcher(rules, z, tt);
+
+    std::vector<int> depths;
+    SearchResult r = searcher.search(bb, History(), depth(3), [&](const SearchInfo& info) {
+        depths.push_back(info.depth);
+        EXPECT_FALSE(info.pv.empty());
+    });
+    EXPECT_EQ(depths, (std::vector<int>{ 1, 2, 3 }));
+    EXPECT_EQ(r.best, r.info.pv.front());
+}
+
+TEST_F(SearchTest, PoolAgreesOnForcedMate) {
+    start("Marseillais Chess", "6k1/5ppp/8/8/4N3/8/8/K3R3 w - - 0 1");
+
+    SearchPool pool(rules, z, tt, 4);
+    EXPECT_EQ(pool.thread_count(), 4);
+    SearchResult r = pool.search(bb, History(), depth(4));
+    EXPECT_EQ(r.info.score, VALUE_MATE - 2);
+    EXPECT_EQ(move_from(r.best), 28);
+    EXPECT_GE(pool.node_count(), r.info.nodes);
+}
+
+TEST_F(SearchTest, PoolStopsFromAnotherThread) {
+    start("Flock-Chess");
+
+    // The stop may land before or after the search starts; either way it ends it
+    SearchPool pool(rules, z, tt, 3);
+    std::thread stopper([&]() { pool.stop(); });
+    SearchResult r = pool.search(bb, History(), depth(MAX_PLY - 1));
+    stopper.join();
+    EXPECT_NE(r.best, NO_MOVE);
+    EXPECT_LT(r.info.depth, MAX_PLY - 1);
+
+    // A stop made between searches ends the next one at once, and only that one
+    pool.stop();
+    r = pool.search(bb, History(), depth(MAX_PLY - 1));
+    EXPECT_NE(r.best, NO_MOVE);
+    EXPECT_EQ(r.info.depth, 0);
+    r = pool.search(bb, History(), depth(2));
+    EXPECT_EQ(r.info.depth, 2);
+
+    // A node limit stops the helpers as well
+    SearchLimits limits;
+    limits.nodes = 20000;
+    r = pool.search(bb, History(), limits);
+    EXPECT_NE(r.best, NO_MOVE);
+}
+
+TEST_F(SearchTest, QuiescenceSeesTheRecapture) {
+    // Qxe5+ wins a pawn at depth 1 unless the recapture dxe5 is searched
+    SearchResult r = run("QE chess", "4k3/8/3p4/4p3/8/8/8/4QK2 w - - 0 1", depth(1));
+    EXPECT_NE(r.best, make_move_code(4, 36, NORMAL, true));
+
+    // Flock: a queen taking a pawn defended by the king's neighbour is lost
+    r = run("Flock-Chess", "4k3/3p4/4p3/8/8/D7/8/4QK2 w - - 0 1", depth(2));
+    EXPECT_NE(r.best, make_move_code(4, 44, NORMAL, true));
+}
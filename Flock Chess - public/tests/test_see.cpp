@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+#include "see.h"
+#include "variant_test.h"
+
+class SeeTest : public VariantTest {
+protected:
+    Evaluator ev;
+
+    void start(const std::string& gameMode, const std::string& fen) {
+        VariantTest::start(gameMode, fen);
+        ev = make_evaluator(bb, rules);
+    }
+
+    int value(char piece) const { return ev.value[bb.piece_id(piece)]; }
+
+    // Reference: every piece whose own attacks from its square reach sq
+    Bitboard forward_attackers(int sq, Bitboard occ) const {
+        Bitboard result = 0ULL;
+        for (Bitboard b = bb.occupancy & ~bb.n_occupancy; b; b &= b - 1) {
+            int from = indexLSB(b);
+            const AttackProgram& program = (*rules.programs)[static_cast<unsigned char>(bb.piece_on(from))];
+            if ((program(from, occ) >> sq) & 1)
+                result |= 1ULL << from;
+        }
+        return result;
+    }
+};
+
+TEST_F(SeeTest, StandardAttackersTo) {
+    start("QE chess", "4k3/8/2n5/1P1r4/2K5/8/8/2Q5 w - - 0 1");
+    Bitboard onC6 = attackers_to(bb, 42, bb.occupancy);
+    EXPECT_EQ(onC6, 1ULL << 33);                            // b5 pawn
+    Bitboard onD4 = attackers_to(bb, 27, bb.occupancy);
+    EXPECT_EQ(onD4, (1ULL << 26) | (1ULL << 35) | (1ULL << 42));    // Kc4, rd5, nc6
+    // The queen's file runs up to the king
+    EXPECT_EQ(attackers_to(bb, 26, bb.occupancy) & (1ULL << 2), 1ULL << 2);
+}
+
+TEST_F(SeeTest, FlockReverseMatchesForwardScan) {
+    start("Flock-Chess", "r1bqkb1r/pppp1ppp/2n2n2/4p3/2B1P3/3D1N2/PPPP1PPP/RNBQK2R w KQkq - 0 4");
+    for (int sq = 0; sq < 64; sq++)
+        EXPECT_EQ(attackers_to(bb, rules, sq, bb.occupancy), forward_attackers(sq, bb.occupancy)) << sq;
+}
+
+TEST_F(SeeTest, SimpleExchanges) {
+    start("QE chess", "4k3/8/3p4/4p3/3P4/8/8/4QK2 w - - 0 1");
+    // dxe5 dxe5 Qxe5 wins a pawn; Qxe5 dxe5 dxe5 loses the queen for two
+    EXPECT_EQ(see(bb, rules, ev, make_move_code(27, 36, NORMAL, true)), value('p'));
+    EXPECT_EQ(see(bb, rules, ev, make_move_code(4, 36, NORMAL, true)), 2 * value('p') - value('Q'));
+    start("QE chess", "4k3/8/8/4n3/3P4/8/8/4K3 w - - 0 1");
+    EXPECT_EQ(see(bb, rules, ev, make_move_code(27, 36, NORMAL, true)), value('n'));        // undefended
+}
+
+TEST_F(SeeTest, XRaysJoinTheExchange) {
+    // Rooks doubled on the e-file against a rook defended once by a rook
+    start("QE chess", "4r1k1/8/8/4r3/8/8/4R3/4R1K1 w - - 0 1");
+    EXPECT_EQ(see(bb, rules, ev, make_move_code(12, 36, NORMAL, true)), value('r'));
+    // Without the second white rook the exchange only trades
+    start("QE chess", "4r1k1/8/8/4r3/8/8/4R3/6K1 w - - 0 1");
+    EXPECT_EQ(see(bb, rules, ev, make_move_code(12, 36, NORMAL, true)), 0);
+}
+
+TEST_F(SeeTest, EnPassantAndPromotion) {
+    start("QE chess", "4k3/8/8/3pP3/8/8/8/4K3 w - d6 0 2");
+    EXPECT_EQ(see(bb, rules, ev, make_move_code(36, 43, EN_PASSANT, true)), value('p'));
+    start("QE chess", "1r2k3/P7/8/8/8/8/8/4K3 w - - 0 1");
+    int queen = bb.piece_id('Q');
+    EXPECT_EQ(see(bb, rules, ev, make_move_code(48, 57, PROMOTION, true, queen)),
+              value('r') + ev.value[queen] - value('P'));
+}
+
+TEST_F(SeeTest, DuckOnlyBlocks) {
+    // The duck on e4 shields e5 from the e1 rook
+    start("Flock-Chess", "4k3/8/3p4/4p3/4D3/8/8/4RK2 w - - 0 1");
+    EXPECT_EQ(attackers_to(bb, rules, 36, bb.occupancy) & bb.w_occupancy, 0ULL);
+    EXPECT_EQ(attackers_to(bb, rules, 36, bb.occupancy ^ (1ULL << 28)) & bb.w_occupancy, 1ULL << 4);
+}
@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+#include "movegen.h"
+
+static PiecePrograms programs_for(const char* pieces, const std::vector<const char*>& movesets) {
+    PiecePrograms programs{};
+    for (size_t i = 0; pieces[i]; i++)
+        programs[(unsigned char)pieces[i]] = compile_moveset(movesets[i]);
+    return programs;
+}
+
+class TargetsTest : public ::testing::Test {
+protected:
+    static void SetUpTestSuite() { init_attack_tables(); }
+};
+
+TEST_F(TargetsTest, OccupancyIsSplitBySide) {
+    Bitboards bb = parse_fen_bitboards("4k3/8/8/8/3+D4/8/8/R3K3 w - - 0 1");
+    EXPECT_EQ(bb.w_occupancy, (1ULL << 0) | (1ULL << 4));
+    EXPECT_EQ(bb.b_occupancy, 1ULL << 60);
+    EXPECT_EQ(bb.n_occupancy, 1ULL << 27);
+    EXPECT_EQ(bb.occupancy, bb.w_occupancy | bb.b_occupancy | bb.n_occupancy);
+
+    // Neutral letters can also come from the variant's piece list
+    Bitboards listed = parse_fen_bitboards("4k3/8/8/8/3D4/8/8/R3K3 w - - 0 1", {}, { 'D' });
+    EXPECT_EQ(listed.n_occupancy, 1ULL << 27);
+    EXPECT_EQ(listed.w_occupancy, bb.w_occupancy);
+}
+
+TEST_F(TargetsTest, CapturesOnlyHitTheEnemy) {
+    // White rook a1 looks up the a-file at a black rook on a5 and along the
+    // first rank at its own king; the duck on a3 is neutral and blocks.
+    PiecePrograms programs = programs_for("RKrkD", { "1", "16", "1", "16", "19" });
+    Bitboards bb = parse_fen_bitboards("4k3/8/8/r7/8/8/8/R3K3 w - - 0 1");
+
+    MoveTargets t;
+    movegen(bb, programs, t);
+    EXPECT_EQ(t.captures[0], 1ULL << 32);                  // Rxa5
+    EXPECT_EQ(t.quiet[0] & bb.occupancy, 0ULL);
+    EXPECT_EQ(t.captures[32], 1ULL << 0);                  // ...Rxa1
+    EXPECT_EQ(t.captures[4], 0ULL);
+
+    Bitboards ducked = parse_fen_bitboards("4k3/8/8/r7/8/+D7/8/R3K3 w - - 0 1");
+    movegen(ducked, programs, t);
+    EXPECT_EQ(t.captures[0], 0ULL);
+    EXPECT_EQ(t.quiet[0] & (1ULL << 8), 1ULL << 8);         // a2 still free
+    EXPECT_EQ(t.quiet[0] & (1ULL << 32), 0ULL);
+    EXPECT_EQ(t.captures[16], 0ULL);                       // the duck takes nothing
+}
+
+TEST_F(TargetsTest, GenTypesSplitTheSamePass) {
+    PiecePrograms programs = programs_for("KQRBNPkqrbnp", { "16", "1+2+3", "1", "2", "3", "17",
+                                                            "16", "1+2+3", "1", "2", "3", "20" });
+    Bitboards bb = parse_fen_bitboards("r1bqkb1r/pppp1ppp/2n2n2/4p3/2B1P3/5N2/PPPP1PPP/RNBQK2R w KQkq - 4 4");
+
+    MoveTargets all, quiets, captures;
+    movegen(bb, programs, all);
+    movegen(bb, programs, quiets, QUIETS);
+    movegen(bb, programs, captures, CAPTURES);
+    MoveBoards merged = movegen(bb, programs);
+
+    for (int sq = 0; sq < 64; sq++) {
+        EXPECT_EQ(quiets.quiet[sq], all.quiet[sq]);
+        EXPECT_EQ(quiets.captures[sq], 0ULL);
+        EXPECT_EQ(captures.captures[sq], all.captures[sq]);
+        EXPECT_EQ(captures.quiet[sq], 0ULL);
+        EXPECT_EQ(merged[sq], all.quiet[sq] | all.captures[sq]);
+    }
+    EXPECT_EQ(all.captures[21], 1ULL << 36);               // Nf3xe5
+    EXPECT_EQ(all.captures[26], 1ULL << 53);               // Bc4xf7
+}
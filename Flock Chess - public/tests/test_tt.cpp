@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <thread>
+#include <vector>
+#include "tt.h"
+
+TEST(TTTest, StoreAndProbe) {
+    TranspositionTable tt(1);
+    EXPECT_EQ(tt.cluster_count() * 64, 1024u * 1024u);
+
+    TTData d;
+    EXPECT_FALSE(tt.probe(0x1234, d));
+    Move m = make_move_code(12, 28, DOUBLE_PUSH);
+    tt.store(0x1234, m, -150, 7, BOUND_LOWER);
+    ASSERT_TRUE(tt.probe(0x1234, d));
+    EXPECT_EQ(d.move, m);
+    EXPECT_EQ(d.value, -150);
+    EXPECT_EQ(d.depth, 7);
+    EXPECT_EQ(d.bound, BOUND_LOWER);
+
+    // No move in the new result keeps the old one
+    tt.store(0x1234, NO_MOVE, 20, 8, BOUND_EXACT);
+    ASSERT_TRUE(tt.probe(0x1234, d));
+    EXPECT_EQ(d.move, m);
+    EXPECT_EQ(d.value, 20);
+
+    tt.clear();
+    EXPECT_FALSE(tt.probe(0x1234, d));
+}
+
+TEST(TTTest, ReplacementPrefersShallowAndOld) {
+    TranspositionTable tt(1);
+    const uint64_t stride = tt.cluster_count();      // same cluster, other keys
+    for (int i = 0; i < TranspositionTable::ENTRIES_PER_CLUSTER; i++)
+        tt.store(5 + i * stride, NO_MOVE, 0, 10 + i, BOUND_EXACT);
+
+    // The depth-10 entry goes first
+    tt.store(5 + 4 * stride, NO_MOVE, 0, 1, BOUND_EXACT);
+    TTData d;
+    EXPECT_FALSE(tt.probe(5, d));
+    EXPECT_TRUE(tt.probe(5 + 1 * stride, d));
+
+    // Two generations later the deep but stale entries lose to anything
+    tt.new_search();
+    tt.new_search();
+    tt.store(5 + 4 * stride, NO_MOVE, 0, 1, BOUND_EXACT);   // refresh the new one
+    tt.store(5 + 5 * stride, NO_MOVE, 0, 1, BOUND_EXACT);
+    EXPECT_TRUE(tt.probe(5 + 4 * stride, d));
+    EXPECT_TRUE(tt.probe(5 + 5 * stride, d));
+    EXPECT_FALSE(tt.probe(5 + 1 * stride, d));
+}
+
+TEST(TTTest, HashfullCountsTheCurrentGeneration) {
+    TranspositionTable tt(1);
+    EXPECT_EQ(tt.hashfull(), 0);
+    for (uint64_t k = 0; k < tt.cluster_count() * 4; k++)
+        tt.store(k * 0x9E3779B97F4A7C15ULL, NO_MOVE, 0, 1, BOUND_EXACT);
+    EXPECT_GT(tt.hashfull(), 500);
+    tt.new_search();
+    EXPECT_EQ(tt.hashfull(), 0);
+}
+
+TEST(TTTest, RacingWritersNeverYieldTornEntries) {
+    // Every writer stores value = depth = a function of the key; a reader
+    // that ever sees a mismatch got half of one write and half of another
+    TranspositionTable tt(1);
+    const uint64_t stride = tt.cluster_count();
+    std::atomic<bool> torn{ false };
+
+    auto writer = [&](uint64_t seed) {
+        std::mt19937_64 rng(seed);
+        for (int i = 0; i < 200000; i++) {
+            uint64_t key = 7 + (rng() % 64) * stride;
+            int v = static_cast<int>(key % 100);
+            tt.store(key, static_cast<Move>(key), v, v, BOUND_EXACT);
+        }
+    };
+    auto reader = [&]() {
+        std::mt19937_64 rng(99);
+        TTData d;
+        for (int i = 0; i < 200000; i++) {
+            uint64_t key = 7 + (rng() % 64) * stride;
+            if (tt.probe(key, d) && (d.value != d.depth || d.move != static_cast<Move>(key)))
+                torn = true;
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.emplace_back(writer, 1);
+    threads.emplace_back(writer, 2);
+    threads.emplace_back(reader);
+    for (auto& t : threads)
+        t.join();
+    EXPECT_FALSE(torn);
+}
@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+#include "makemove.h"
+
+static const std::vector<char> PIECES = { 'K', 'Q', 'R', 'B', 'N', 'P', 'k', 'q', 'r', 'b', 'n', 'p', 'D' };
+static const char* FLOCK_START = "rnbqkbnr/pppppppp/8/1D1D1D/2D1D1/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+TEST(ZobristTest, KeysAreFixed) {
+    Zobrist a, b;
+    init_zobrist(a, PIECES, 2);
+    init_zobrist(b, PIECES, 2);
+    EXPECT_EQ(a.piece_square, b.piece_square);
+    EXPECT_EQ(a.quantum_square, b.quantum_square);
+    EXPECT_EQ(a.castling_rights, b.castling_rights);
+    EXPECT_EQ(a.enpassant_file, b.enpassant_file);
+    EXPECT_EQ(a.side_to_move, b.side_to_move);
+    EXPECT_EQ(a.sub_move, b.sub_move);
+
+    // Known value: a hash persisted by another process must still match
+    EXPECT_EQ(a.piece_square[0][4], zobrist_key(ZS_PIECE + 'K', 4));
+    static_assert(zobrist_key(ZS_SIDE, 0) != 0, "side key is set at compile time");
+}
+
+TEST(ZobristTest, PieceKeysFollowTheLetter) {
+    std::vector<char> reordered(PIECES.rbegin(), PIECES.rend());
+    Zobrist a, b;
+    init_zobrist(a, PIECES, 0);
+    init_zobrist(b, reordered, 0);
+
+    Bitboards x = parse_fen_bitboards(FLOCK_START, PIECES, { 'D' });
+    Bitboards y = parse_fen_bitboards(FLOCK_START, reordered, { 'D' });
+    EXPECT_EQ(compute_zobrist(x, a), compute_zobrist(y, b));
+}
+
+TEST(ZobristTest, SubMoveIndexIsHashedIncrementally) {
+    Zobrist z;
+    init_zobrist(z, PIECES, 0);
+    Bitboards bb = parse_fen_bitboards(FLOCK_START, PIECES, { 'D' });
+    bb.moves_per_turn = 2;
+    bb.zobrist_hash = compute_zobrist(bb, z);
+    uint64_t start = bb.zobrist_hash;
+
+    // Same placement and side to move, different point in the turn
+    Move out = make_move_code(6, 21), back = make_move_code(21, 6);
+    UndoInfo u1, u2;
+    make_move(bb, out, u1, z);
+    EXPECT_EQ(bb.sub_move, 1);
+    EXPECT_EQ(bb.zobrist_hash, compute_zobrist(bb, z));
+
+    Bitboards fresh = parse_fen_bitboards("rnbqkbnr/pppppppp/8/1D1D1D/2D1D1/5N2/PPPPPPPP/RNBQKB1R w KQkq - 0 1",
+                                          PIECES, { 'D' });
+    EXPECT_NE(bb.zobrist_hash, compute_zobrist(fresh, z));
+
+    make_move(bb, back, u2, z);
+    EXPECT_EQ(bb.sub_move, 0);
+    EXPECT_EQ(bb.zobrist_hash, compute_zobrist(bb, z));
+    EXPECT_EQ(bb.zobrist_hash, start ^ z.side_to_move);     // Black to move now
+
+    unmake_move(bb, back, u2);
+    unmake_move(bb, out, u1);
+    EXPECT_EQ(bb.zobrist_hash, start);
+}
@@ -0,0 +1,32 @@
+// variant_test.h
+#pragma once
+#include <gtest/gtest.h>
+#include "rules.h"
+
+// Base fixture for tests that play the variants of src/variants.ini (the
+// target defines FLOCK_VARIANTS_INI). The file is parsed once per test
+// binary; start() sets up one variant's rules, keys and board.
+class VariantTest : public ::testing::Test {
+protected:
+    inline static std::unordered_map<std::string, Variant> variants;
+
+    const Variant* v = nullptr;
+    GameRules rules;
+    Zobrist z;
+    Bitboards bb;
+
+    static void SetUpTestSuite() {
+        init_attack_tables();
+        if (variants.empty())
+            variants = parse(FLOCK_VARIANTS_INI);
+    }
+
+    // An empty fen is the variant's start position
+    void start(const std::string& gameMode, const std::string& fen = "") {
+        v = &variants.at(gameMode);
+        rules = rules_for(*v);
+        init_zobrist(z, v->pieces, 0);
+        bb = setup_board(*v, rules, fen.empty() ? v->stdPos : fen);
+        bb.zobrist_hash = compute_zobrist(bb, z);
+    }
+};